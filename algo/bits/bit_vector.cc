@@ -0,0 +1,252 @@
+#include "bits/bit_vector.h"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace algo {
+namespace {
+enum class Op { AND, OR, XOR, AND_NOT };
+
+using BinaryKernel = void (*)(const uint64_t* lhs, const uint64_t* rhs, uint64_t* out, uint64_t n);
+using PopCountKernel = uint64_t (*)(const uint64_t* blocks, uint64_t n);
+
+template <Op op>
+uint64_t Apply(uint64_t lhs, uint64_t rhs) {
+  switch (op) {
+    case Op::AND:
+      return lhs & rhs;
+    case Op::OR:
+      return lhs | rhs;
+    case Op::XOR:
+      return lhs ^ rhs;
+    case Op::AND_NOT:
+      return lhs & ~rhs;
+  }
+}
+
+template <Op op>
+void Portable(const uint64_t* lhs, const uint64_t* rhs, uint64_t* out, uint64_t n) {
+  for (uint64_t i = 0; i < n; ++i)
+    out[i] = Apply<op>(lhs[i], rhs[i]);
+}
+
+uint64_t PortablePopCount(const uint64_t* blocks, uint64_t n) {
+  uint64_t count = 0;
+  for (uint64_t i = 0; i < n; ++i)
+    count += std::popcount(blocks[i]);
+  return count;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("popcnt"))) uint64_t PopcntPopCount(const uint64_t* blocks, uint64_t n) {
+  uint64_t count = 0;
+  for (uint64_t i = 0; i < n; ++i)
+    count += _mm_popcnt_u64(blocks[i]);
+  return count;
+}
+
+template <Op op>
+__attribute__((target("avx2"))) __m256i Avx2Apply(__m256i lhs, __m256i rhs) {
+  switch (op) {
+    case Op::AND:
+      return _mm256_and_si256(lhs, rhs);
+    case Op::OR:
+      return _mm256_or_si256(lhs, rhs);
+    case Op::XOR:
+      return _mm256_xor_si256(lhs, rhs);
+    case Op::AND_NOT:
+      return _mm256_andnot_si256(rhs, lhs);
+  }
+}
+
+template <Op op>
+__attribute__((target("avx2"))) void Avx2(const uint64_t* lhs, const uint64_t* rhs, uint64_t* out, uint64_t n) {
+  uint64_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), Avx2Apply<op>(a, b));
+  }
+  for (; i < n; ++i)
+    out[i] = Apply<op>(lhs[i], rhs[i]);
+}
+
+// Counts ones with a nibble lookup table in a byte shuffle, see
+// W. Mula, N. Kurz, D. Lemire, "Faster Population Counts Using AVX2
+// Instructions".
+__attribute__((target("avx2"))) uint64_t Avx2PopCount(const uint64_t* blocks, uint64_t n) {
+  const __m256i lookup =
+      _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i lowMask = _mm256_set1_epi8(0x0F);
+
+  __m256i counts = _mm256_setzero_si256();
+  uint64_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks + i));
+    const __m256i lo = _mm256_and_si256(v, lowMask);
+    const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowMask);
+    const __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+    counts = _mm256_add_epi64(counts, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+  }
+
+  uint64_t count = _mm256_extract_epi64(counts, 0) + _mm256_extract_epi64(counts, 1) +
+                   _mm256_extract_epi64(counts, 2) + _mm256_extract_epi64(counts, 3);
+  for (; i < n; ++i)
+    count += std::popcount(blocks[i]);
+  return count;
+}
+
+template <Op op>
+__attribute__((target("avx512f"))) __m512i Avx512Apply(__m512i lhs, __m512i rhs) {
+  switch (op) {
+    case Op::AND:
+      return _mm512_and_si512(lhs, rhs);
+    case Op::OR:
+      return _mm512_or_si512(lhs, rhs);
+    case Op::XOR:
+      return _mm512_xor_si512(lhs, rhs);
+    case Op::AND_NOT:
+      // _mm512_andnot_si512() triggers false -Wmaybe-uninitialized in
+      // GCC 12 headers, compilers fold this into vpandn anyway.
+      return _mm512_and_si512(lhs, _mm512_xor_si512(rhs, _mm512_set1_epi64(-1)));
+  }
+}
+
+template <Op op>
+__attribute__((target("avx512f"))) void Avx512(const uint64_t* lhs, const uint64_t* rhs, uint64_t* out, uint64_t n) {
+  uint64_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m512i a = _mm512_loadu_si512(lhs + i);
+    const __m512i b = _mm512_loadu_si512(rhs + i);
+    _mm512_storeu_si512(out + i, Avx512Apply<op>(a, b));
+  }
+  if (i < n) {
+    const __mmask8 mask = (1 << (n - i)) - 1;
+    const __m512i a = _mm512_maskz_loadu_epi64(mask, lhs + i);
+    const __m512i b = _mm512_maskz_loadu_epi64(mask, rhs + i);
+    _mm512_mask_storeu_epi64(out + i, mask, Avx512Apply<op>(a, b));
+  }
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq"))) uint64_t Avx512PopCount(const uint64_t* blocks, uint64_t n) {
+  __m512i counts = _mm512_setzero_si512();
+  uint64_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    counts = _mm512_add_epi64(counts, _mm512_popcnt_epi64(_mm512_loadu_si512(blocks + i)));
+  if (i < n) {
+    const __mmask8 mask = (1 << (n - i)) - 1;
+    counts = _mm512_add_epi64(counts, _mm512_popcnt_epi64(_mm512_maskz_loadu_epi64(mask, blocks + i)));
+  }
+  uint64_t lanes[8];
+  _mm512_storeu_si512(lanes, counts);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7];
+}
+#endif
+
+struct Kernels {
+  Kernels() {
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+      m_and = Avx512<Op::AND>;
+      m_or = Avx512<Op::OR>;
+      m_xor = Avx512<Op::XOR>;
+      m_andNot = Avx512<Op::AND_NOT>;
+    } else if (__builtin_cpu_supports("avx2")) {
+      m_and = Avx2<Op::AND>;
+      m_or = Avx2<Op::OR>;
+      m_xor = Avx2<Op::XOR>;
+      m_andNot = Avx2<Op::AND_NOT>;
+    }
+
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq"))
+      m_popCount = Avx512PopCount;
+    else if (__builtin_cpu_supports("avx2"))
+      m_popCount = Avx2PopCount;
+    else if (__builtin_cpu_supports("popcnt"))
+      m_popCount = PopcntPopCount;
+#endif
+  }
+
+  BinaryKernel m_and = Portable<Op::AND>;
+  BinaryKernel m_or = Portable<Op::OR>;
+  BinaryKernel m_xor = Portable<Op::XOR>;
+  BinaryKernel m_andNot = Portable<Op::AND_NOT>;
+  PopCountKernel m_popCount = PortablePopCount;
+};
+
+const Kernels& GetKernels() {
+  static const Kernels kernels;
+  return kernels;
+}
+
+void Run(BinaryKernel kernel, const BitVector& lhs, const BitVector& rhs, BitVector& out) {
+  assert(lhs.NumBits() == rhs.NumBits());
+  assert(lhs.NumBits() == out.NumBits());
+  kernel(&lhs.Block(0), &rhs.Block(0), &out.Block(0), out.NumBlocks());
+}
+}  // namespace
+
+// static
+void BitVector::And(const BitVector& lhs, const BitVector& rhs, BitVector& out) {
+  Run(GetKernels().m_and, lhs, rhs, out);
+}
+
+// static
+void BitVector::Or(const BitVector& lhs, const BitVector& rhs, BitVector& out) {
+  Run(GetKernels().m_or, lhs, rhs, out);
+}
+
+// static
+void BitVector::Xor(const BitVector& lhs, const BitVector& rhs, BitVector& out) {
+  Run(GetKernels().m_xor, lhs, rhs, out);
+}
+
+// static
+void BitVector::AndNot(const BitVector& lhs, const BitVector& rhs, BitVector& out) {
+  Run(GetKernels().m_andNot, lhs, rhs, out);
+}
+
+uint64_t BitVector::PopCount(uint64_t from, uint64_t to) const {
+  assert(from <= to);
+  assert(to <= m_numBits);
+  if (from == to)
+    return 0;
+
+  const uint64_t first = from >> 6;
+  const uint64_t last = (to - 1) >> 6;
+  const uint64_t firstMask = ~static_cast<uint64_t>(0) << (from & 0x3F);
+  const uint64_t lastMask = ~static_cast<uint64_t>(0) >> (63 - ((to - 1) & 0x3F));
+  if (first == last)
+    return std::popcount(m_blocks[first] & firstMask & lastMask);
+
+  return std::popcount(m_blocks[first] & firstMask) + GetKernels().m_popCount(&m_blocks[first + 1], last - first - 1) +
+         std::popcount(m_blocks[last] & lastMask);
+}
+
+void BitVector::Fill(uint64_t from, uint64_t to, bool value) {
+  assert(from <= to);
+  assert(to <= m_numBits);
+  if (from == to)
+    return;
+
+  const uint64_t first = from >> 6;
+  const uint64_t last = (to - 1) >> 6;
+  const uint64_t firstMask = ~static_cast<uint64_t>(0) << (from & 0x3F);
+  const uint64_t lastMask = ~static_cast<uint64_t>(0) >> (63 - ((to - 1) & 0x3F));
+  const auto fill = [value](uint64_t& block, uint64_t mask) { block = value ? block | mask : block & ~mask; };
+
+  if (first == last) {
+    fill(m_blocks[first], firstMask & lastMask);
+    return;
+  }
+
+  fill(m_blocks[first], firstMask);
+  std::fill(m_blocks.begin() + first + 1, m_blocks.begin() + last, value ? ~static_cast<uint64_t>(0) : 0);
+  fill(m_blocks[last], lastMask);
+}
+}  // namespace algo
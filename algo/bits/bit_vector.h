@@ -1,11 +1,18 @@
 #pragma once
 
+#include "bits/bits.h"
+
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
 #include <vector>
 
 namespace algo {
+class BitVectorBuilder;
+
 class BitVector {
 public:
 #define BLOCK_OFFSET(bit)          \
@@ -39,6 +46,138 @@ public:
     return m_blocks[block] & (static_cast<uint64_t>(1) << offset);
   }
 
+  // Returns |len| bits starting from |bit| packed into a number,
+  // where 0 <= |len| <= 64.
+  uint64_t GetBits(uint64_t bit, uint8_t len) const {
+    assert(len <= 64);
+    assert(bit + len <= m_numBits);
+    BLOCK_OFFSET(bit);
+    uint64_t value = m_blocks[block] >> offset;
+    if (offset + len > 64)
+      value |= m_blocks[block + 1] << (64 - offset);
+    return value & LowMask(len);
+  }
+
+  // Sets |len| bits starting from |bit| to lowest |len| bits of
+  // |value|, where 0 <= |len| <= 64.
+  void SetBits(uint64_t bit, uint8_t len, uint64_t value) {
+    assert(len <= 64);
+    assert(bit + len <= m_numBits);
+    BLOCK_OFFSET(bit);
+    const uint64_t mask = LowMask(len);
+    value &= mask;
+    m_blocks[block] = (m_blocks[block] & ~(mask << offset)) | (value << offset);
+    if (offset + len > 64) {
+      const uint64_t shift = 64 - offset;
+      m_blocks[block + 1] = (m_blocks[block + 1] & ~(mask >> shift)) | (value >> shift);
+    }
+  }
+
+  // In-place bulk logical operations, |rhs| should have the same
+  // number of bits. AndNot() computes this & ~rhs.
+  //
+  // These and other bulk operations use AVX-512 or AVX2 when the CPU
+  // supports them, the choice is made once at runtime.
+  void And(const BitVector& rhs) { And(*this, rhs, *this); }
+  void Or(const BitVector& rhs) { Or(*this, rhs, *this); }
+  void Xor(const BitVector& rhs) { Xor(*this, rhs, *this); }
+  void AndNot(const BitVector& rhs) { AndNot(*this, rhs, *this); }
+
+  // Out-of-place bulk logical operations, all bit vectors should
+  // have the same number of bits. |out| may be the same as |lhs| or
+  // |rhs|.
+  static void And(const BitVector& lhs, const BitVector& rhs, BitVector& out);
+  static void Or(const BitVector& lhs, const BitVector& rhs, BitVector& out);
+  static void Xor(const BitVector& lhs, const BitVector& rhs, BitVector& out);
+  static void AndNot(const BitVector& lhs, const BitVector& rhs, BitVector& out);
+
+  // Returns number of ones among all bits.
+  uint64_t PopCount() const { return PopCount(0, m_numBits); }
+
+  // Returns number of ones among bits in the range [|from|, |to|).
+  uint64_t PopCount(uint64_t from, uint64_t to) const;
+
+  // Sets all bits in the range [|from|, |to|) to |value|.
+  void Fill(uint64_t from, uint64_t to, bool value);
+
+  // Returns position of the first one at or after |from|, if any.
+  std::optional<uint64_t> NextSetBit(uint64_t from) const {
+    assert(from <= m_numBits);
+    if (from == m_numBits)
+      return {};
+    BLOCK_OFFSET(from);
+    uint64_t b = block;
+    uint64_t bits = m_blocks[b] & (~static_cast<uint64_t>(0) << offset);
+    while (bits == 0) {
+      if (++b == m_blocks.size())
+        return {};
+      bits = m_blocks[b];
+    }
+    return (b << 6) + LoPosUnsafe(bits);
+  }
+
+  // Returns position of the last one before |to|, if any.
+  std::optional<uint64_t> PrevSetBit(uint64_t to) const {
+    assert(to <= m_numBits);
+    if (to == 0)
+      return {};
+    const uint64_t last = to - 1;
+    BLOCK_OFFSET(last);
+    uint64_t b = block;
+    uint64_t bits = m_blocks[b] & (~static_cast<uint64_t>(0) >> (63 - offset));
+    while (bits == 0) {
+      if (b == 0)
+        return {};
+      bits = m_blocks[--b];
+    }
+    return (b << 6) + HiPosUnsafe(bits);
+  }
+
+  // Calls |fn| for positions of all ones in increasing order. Skips
+  // whole zero blocks and spends O(1) per one.
+  template <typename Fn>
+  void ForEachSetBit(Fn&& fn) const {
+    for (uint64_t b = 0; b < m_blocks.size(); ++b) {
+      for (uint64_t bits = m_blocks[b]; bits != 0; bits &= bits - 1)
+        fn((b << 6) + LoPosUnsafe(bits));
+    }
+  }
+
+  // Calls |fn| for positions of all zeroes in increasing order.
+  template <typename Fn>
+  void ForEachClearBit(Fn&& fn) const {
+    for (uint64_t b = 0; b < m_blocks.size(); ++b) {
+      uint64_t bits = ~m_blocks[b];
+      if ((b + 1) << 6 > m_numBits)
+        bits &= (static_cast<uint64_t>(1) << (m_numBits & 0x3F)) - 1;
+      for (; bits != 0; bits &= bits - 1)
+        fn((b << 6) + LoPosUnsafe(bits));
+    }
+  }
+
+  // Writes positions of the first ones at or after |from| to |out|,
+  // until |out| is full or there are no more ones. Returns number of
+  // written positions. Decoding continues from out[n - 1] + 1.
+  size_t DecodeSetBits(uint64_t from, std::span<uint64_t> out) const {
+    assert(from <= m_numBits);
+    if (from == m_numBits || out.empty())
+      return 0;
+    BLOCK_OFFSET(from);
+    size_t n = 0;
+    uint64_t b = block;
+    uint64_t bits = m_blocks[b] & (~static_cast<uint64_t>(0) << offset);
+    while (true) {
+      for (; bits != 0; bits &= bits - 1) {
+        out[n++] = (b << 6) + LoPosUnsafe(bits);
+        if (n == out.size())
+          return n;
+      }
+      if (++b == m_blocks.size())
+        return n;
+      bits = m_blocks[b];
+    }
+  }
+
   uint64_t& Block(uint64_t block) {
     assert(block < m_blocks.size());
     return m_blocks[block];
@@ -54,6 +193,16 @@ public:
   uint64_t NumBlocks() const { return m_blocks.size(); }
 
 private:
+  friend class BitVectorBuilder;
+
+  // Takes ownership of |blocks|, which should already have the layout
+  // described above.
+  BitVector(std::vector<uint64_t>&& blocks, uint64_t numBits) : m_blocks(std::move(blocks)), m_numBits(numBits) {
+    assert(m_blocks.size() == ((numBits + 63) >> 6) + (numBits % 64 == 0));
+  }
+
+  static uint64_t LowMask(uint8_t len) { return len == 64 ? ~static_cast<uint64_t>(0) : (static_cast<uint64_t>(1) << len) - 1; }
+
   std::vector<uint64_t> m_blocks;
   uint64_t const m_numBits;
 };
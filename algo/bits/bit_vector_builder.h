@@ -0,0 +1,63 @@
+#pragma once
+
+#include "bits/bit_vector.h"
+
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace algo {
+// Append-only builder for a BitVector, for the case when number of
+// bits is not known in advance. Storage grows geometrically, so
+// appends are amortized O(1), and Build() moves the storage into
+// the BitVector without copying. To allow this, there is always a
+// block for the position after the last bit, as in BitVector.
+//
+// An RSTable for the result is built as usual, from the returned
+// BitVector, as it only refers to the bits.
+class BitVectorBuilder {
+public:
+  BitVectorBuilder() : m_blocks(1) {}
+
+  // Reserves space for |numBits| bits in total.
+  void Reserve(uint64_t numBits) { m_blocks.reserve((numBits >> 6) + 1); }
+
+  void PushBack(bool bit) {
+    m_blocks.back() |= static_cast<uint64_t>(bit) << (m_numBits & 0x3F);
+    ++m_numBits;
+    if ((m_numBits & 0x3F) == 0)
+      m_blocks.push_back(0);
+  }
+
+  // Appends lowest |len| bits of |word|, starting from the least
+  // significant one, where 0 <= |len| <= 64.
+  void PushBackBits(uint64_t word, uint8_t len) {
+    assert(len <= 64);
+    if (len == 0)
+      return;
+    if (len < 64)
+      word &= (static_cast<uint64_t>(1) << len) - 1;
+
+    const uint64_t offset = m_numBits & 0x3F;
+    m_blocks.back() |= word << offset;
+    if (offset + len >= 64)
+      m_blocks.push_back(offset == 0 ? 0 : word >> (64 - offset));
+    m_numBits += len;
+  }
+
+  uint64_t NumBits() const { return m_numBits; }
+
+  // Returns built bit vector, the builder is left empty.
+  BitVector Build() {
+    BitVector bv(std::move(m_blocks), m_numBits);
+    m_blocks.assign(1, 0);
+    m_numBits = 0;
+    return bv;
+  }
+
+private:
+  std::vector<uint64_t> m_blocks;
+  uint64_t m_numBits{};
+};
+}  // namespace algo
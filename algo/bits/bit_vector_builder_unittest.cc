@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "bits/bit_vector.h"
+#include "bits/bit_vector_builder.h"
+#include "bits/rs_table.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace algo;
+
+namespace {
+TEST(Bits, BitVectorBuilder_Smoke) {
+  BitVectorBuilder builder;
+  {
+    const auto bv = builder.Build();
+    ASSERT_EQ(0, bv.NumBits());
+    ASSERT_EQ(1, bv.NumBlocks());
+  }
+
+  for (const uint64_t size : {1, 63, 64, 65, 128, 1000}) {
+    for (uint64_t i = 0; i < size; ++i)
+      builder.PushBack(i % 3 == 0);
+    ASSERT_EQ(size, builder.NumBits());
+
+    const auto bv = builder.Build();
+    ASSERT_EQ(0, builder.NumBits());
+    ASSERT_EQ(size, bv.NumBits());
+    ASSERT_EQ(BitVector(size).NumBlocks(), bv.NumBlocks());
+    for (uint64_t i = 0; i < size; ++i)
+      ASSERT_EQ(i % 3 == 0, bv.Test(i));
+
+    RSTable rs(bv);
+    ASSERT_EQ((size + 2) / 3, rs.Rank1(size));
+  }
+}
+
+TEST(Bits, BitVectorBuilder_Bits) {
+  std::mt19937_64 engine(42);
+
+  BitVectorBuilder builder;
+  builder.Reserve(10000);
+
+  std::vector<bool> expected;
+  for (int i = 0; i < 1000; ++i) {
+    const uint64_t word = engine();
+    const uint8_t len = engine() % 65;
+    builder.PushBackBits(word, len);
+    for (uint8_t j = 0; j < len; ++j)
+      expected.push_back((word >> j) & 1);
+    if (i % 7 == 0) {
+      builder.PushBack(true);
+      expected.push_back(true);
+    }
+  }
+
+  const auto bv = builder.Build();
+  ASSERT_EQ(expected.size(), bv.NumBits());
+  for (uint64_t i = 0; i < bv.NumBits(); ++i)
+    ASSERT_EQ(expected[i], bv.Test(i));
+
+  // Bits after the last one should be zero.
+  ASSERT_EQ(std::count(expected.begin(), expected.end(), true), bv.PopCount());
+  ASSERT_EQ(0, bv.Block(bv.NumBlocks() - 1) >> (bv.NumBits() % 64));
+}
+
+TEST(Bits, BitVectorBuilder_Words) {
+  BitVectorBuilder builder;
+  for (uint64_t size = 1; size <= 3; ++size) {
+    for (uint64_t i = 0; i < size; ++i)
+      builder.PushBackBits(~i, 64);
+
+    const auto bv = builder.Build();
+    ASSERT_EQ(64 * size, bv.NumBits());
+    ASSERT_EQ(size + 1, bv.NumBlocks());
+    for (uint64_t i = 0; i < size; ++i)
+      ASSERT_EQ(~i, bv.Block(i));
+    ASSERT_EQ(0, bv.Block(size));
+  }
+}
+}  // namespace
@@ -2,6 +2,11 @@
 
 #include "bits/bit_vector.h"
 
+#include <algorithm>
+#include <optional>
+#include <random>
+#include <vector>
+
 namespace algo {
 TEST(Bits, BitVector) {
   BitVector bits{10};
@@ -31,4 +36,163 @@ TEST(Bits, BitVector) {
     ASSERT_TRUE(bits.Test(i));
   ASSERT_EQ(static_cast<uint64_t>(0b1001001000), bits.Block(0));
 }
+
+TEST(Bits, BitVector_Bits) {
+  BitVector bits{200};
+  bits.SetBits(0, 4, 0b1011);
+  ASSERT_EQ(static_cast<uint64_t>(0b1011), bits.GetBits(0, 4));
+  ASSERT_EQ(static_cast<uint64_t>(0b101), bits.GetBits(1, 3));
+  ASSERT_EQ(static_cast<uint64_t>(0), bits.GetBits(0, 0));
+
+  // Crosses a block boundary.
+  bits.SetBits(60, 10, 0x3FF);
+  ASSERT_EQ(static_cast<uint64_t>(0x3FF), bits.GetBits(60, 10));
+  ASSERT_EQ(static_cast<uint64_t>(0b1011), bits.GetBits(0, 4));
+  for (uint64_t i = 60; i < 70; ++i)
+    ASSERT_TRUE(bits.Test(i));
+  ASSERT_FALSE(bits.Test(59));
+  ASSERT_FALSE(bits.Test(70));
+
+  bits.SetBits(62, 4, 0b0110);
+  ASSERT_EQ(static_cast<uint64_t>(0b1111011011), bits.GetBits(60, 10));
+
+  bits.SetBits(100, 64, 0xDEADBEEFCAFEBABE);
+  ASSERT_EQ(static_cast<uint64_t>(0xDEADBEEFCAFEBABE), bits.GetBits(100, 64));
+  ASSERT_EQ(static_cast<uint64_t>(0b1111011011), bits.GetBits(60, 10));
+
+  bits.SetBits(136, 64, 0);
+  ASSERT_EQ(static_cast<uint64_t>(0xFCAFEBABE), bits.GetBits(100, 64));
+}
+
+TEST(Bits, BitVector_Logical) {
+  std::mt19937_64 engine(42);
+
+  for (const uint64_t size : {0, 1, 63, 64, 65, 300, 511, 512, 513, 1000, 4097}) {
+    BitVector lhs(size);
+    BitVector rhs(size);
+    for (uint64_t i = 0; i < size; ++i) {
+      if (engine() % 2 == 0)
+        lhs.Set(i);
+      if (engine() % 3 == 0)
+        rhs.Set(i);
+    }
+
+    BitVector out(size);
+    BitVector::And(lhs, rhs, out);
+    for (uint64_t i = 0; i < size; ++i)
+      ASSERT_EQ(lhs.Test(i) && rhs.Test(i), out.Test(i));
+    BitVector::Or(lhs, rhs, out);
+    for (uint64_t i = 0; i < size; ++i)
+      ASSERT_EQ(lhs.Test(i) || rhs.Test(i), out.Test(i));
+    BitVector::Xor(lhs, rhs, out);
+    for (uint64_t i = 0; i < size; ++i)
+      ASSERT_EQ(lhs.Test(i) != rhs.Test(i), out.Test(i));
+    BitVector::AndNot(lhs, rhs, out);
+    for (uint64_t i = 0; i < size; ++i)
+      ASSERT_EQ(lhs.Test(i) && !rhs.Test(i), out.Test(i));
+
+    BitVector bits = lhs;
+    bits.Or(rhs);
+    bits.AndNot(lhs);
+    // Now |bits| is rhs & ~lhs.
+    bits.Xor(rhs);
+    // Now |bits| is rhs & lhs.
+    bits.And(lhs);
+    for (uint64_t i = 0; i < size; ++i)
+      ASSERT_EQ(lhs.Test(i) && rhs.Test(i), bits.Test(i));
+  }
+}
+
+TEST(Bits, BitVector_PopCountFill) {
+  std::mt19937_64 engine(42);
+
+  BitVector bits(2000);
+  for (uint64_t i = 0; i < bits.NumBits(); ++i) {
+    if (engine() % 2 == 0)
+      bits.Set(i);
+  }
+
+  const auto naive = [&bits](uint64_t from, uint64_t to) {
+    uint64_t count = 0;
+    for (uint64_t i = from; i < to; ++i)
+      count += bits.Test(i);
+    return count;
+  };
+
+  ASSERT_EQ(naive(0, bits.NumBits()), bits.PopCount());
+  for (int i = 0; i < 1000; ++i) {
+    uint64_t from = engine() % (bits.NumBits() + 1);
+    uint64_t to = engine() % (bits.NumBits() + 1);
+    if (from > to)
+      std::swap(from, to);
+    ASSERT_EQ(naive(from, to), bits.PopCount(from, to)) << from << " " << to;
+  }
+
+  for (int i = 0; i < 100; ++i) {
+    uint64_t from = engine() % (bits.NumBits() + 1);
+    uint64_t to = engine() % (bits.NumBits() + 1);
+    if (from > to)
+      std::swap(from, to);
+    const bool value = engine() % 2 == 0;
+
+    BitVector expected = bits;
+    for (uint64_t j = from; j < to; ++j) {
+      if (value)
+        expected.Set(j);
+      else
+        expected.Clear(j);
+    }
+
+    bits.Fill(from, to, value);
+    for (uint64_t j = 0; j < bits.NumBlocks(); ++j)
+      ASSERT_EQ(expected.Block(j), bits.Block(j));
+  }
+}
+
+TEST(Bits, BitVector_Iteration) {
+  std::mt19937_64 engine(42);
+
+  for (const uint64_t size : {0, 1, 63, 64, 65, 128, 1000}) {
+    for (const int density : {0, 1, 10, 50, 100}) {
+      BitVector bits(size);
+      std::vector<uint64_t> ones;
+      std::vector<uint64_t> zeros;
+      for (uint64_t i = 0; i < size; ++i) {
+        if (static_cast<int>(engine() % 100) < density) {
+          bits.Set(i);
+          ones.push_back(i);
+        } else {
+          zeros.push_back(i);
+        }
+      }
+
+      std::vector<uint64_t> actual;
+      bits.ForEachSetBit([&](uint64_t i) { actual.push_back(i); });
+      ASSERT_EQ(ones, actual);
+
+      actual.clear();
+      bits.ForEachClearBit([&](uint64_t i) { actual.push_back(i); });
+      ASSERT_EQ(zeros, actual);
+
+      for (uint64_t i = 0; i <= size; ++i) {
+        const auto next = std::lower_bound(ones.begin(), ones.end(), i);
+        ASSERT_EQ(next == ones.end() ? std::nullopt : std::optional<uint64_t>(*next), bits.NextSetBit(i));
+
+        const auto prev = std::lower_bound(ones.begin(), ones.end(), i);
+        ASSERT_EQ(prev == ones.begin() ? std::nullopt : std::optional<uint64_t>(*std::prev(prev)), bits.PrevSetBit(i));
+      }
+
+      for (const size_t batch : {1, 3, 64}) {
+        actual.clear();
+        std::vector<uint64_t> buffer(batch);
+        uint64_t from = 0;
+        while (const size_t n = bits.DecodeSetBits(from, buffer)) {
+          actual.insert(actual.end(), buffer.begin(), buffer.begin() + n);
+          from = buffer[n - 1] + 1;
+        }
+        ASSERT_EQ(ones, actual);
+      }
+    }
+  }
+}
 }  // namespace algo
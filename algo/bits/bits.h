@@ -1,9 +1,15 @@
 #pragma once
 
+#include <array>
 #include <bit>
 #include <cassert>
 #include <climits>
 #include <cstdint>
+#include <type_traits>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
 
 namespace algo {
 inline constexpr uint64_t GenL(uint8_t k, uint8_t i) {
@@ -49,4 +55,197 @@ inline constexpr uint8_t HiPos(uint64_t x) noexcept { return x == 0 ? 0 : HiPosU
 // Returns mask corresponding to lsb 1 in |x|. When |x| is zero, returns zero
 // too.
 inline constexpr uint64_t LSB(uint64_t x) noexcept { return x & (~x + 1); }
+
+// Returns word whose i-th byte holds number of ones in the i-th byte
+// of |x|.
+inline constexpr uint64_t PopCountBytes(uint64_t x) noexcept {
+  x = x - ((x >> 1) & L(2));
+  x = (x & L(4) * 0x3) + ((x >> 2) & L(4) * 0x3);
+  return (x + (x >> 4)) & L(8) * 0xF;
+}
+
+// Calculates position of the |k|-th (0-based) 1 in |x|. |k| should
+// be less than PopCount(x).
+//
+// When BMI2 is available, a single PDEP deposits 1 << k on the k-th
+// set bit of |x|. Otherwise, a broadword algorithm is used: byte-wise
+// popcounts are summed into cumulative counts by a multiplication,
+// the byte holding the answer is found by a parallel comparison
+// against |k|, and the remaining few ones are skipped inside that
+// byte.
+inline constexpr uint8_t SelectInWord(uint64_t x, uint8_t k) noexcept {
+  assert(k < PopCount(x));
+#if defined(__BMI2__)
+  if (!std::is_constant_evaluated())
+    return LoPosUnsafe(_pdep_u64(static_cast<uint64_t>(1) << k, x));
+#endif
+  // i-th byte of |sums| is a number of ones in first i + 1 bytes of |x|.
+  const uint64_t sums = PopCountBytes(x) * L(8);
+
+  // MSB of i-th byte of |leq| is set iff sums[i] <= k.
+  const uint64_t leq = ((k * L(8)) | H(8)) - sums;
+  const uint8_t byte = CHAR_BIT * PopCount(leq & H(8));
+
+  uint8_t rank = k - static_cast<uint8_t>(((sums << 8) >> byte) & 0xFF);
+  uint64_t bits = (x >> byte) & 0xFF;
+  for (; rank != 0; --rank)
+    bits &= bits - 1;
+  return byte + LoPosUnsafe(bits);
+}
+
+namespace impl {
+// Returns mask of bits that move by 2^i positions on the |i|-th step
+// of PextBroadword(|x|, |mask|), for i in [0, 6). See H. Warren,
+// "Hacker's Delight", 7-4.
+inline constexpr std::array<uint64_t, 6> CompressMoves(uint64_t mask) noexcept {
+  std::array<uint64_t, 6> moves{};
+  // i-th bit of |mk| is set iff there is a zero in |mask| to the right
+  // of the i-th bit, so that parity of ones in |mk| on the right gives
+  // the next bit of the shift of each bit of |mask|.
+  uint64_t mk = ~mask << 1;
+  for (unsigned i = 0; i < moves.size(); ++i) {
+    uint64_t mp = mk ^ (mk << 1);
+    mp ^= mp << 2;
+    mp ^= mp << 4;
+    mp ^= mp << 8;
+    mp ^= mp << 16;
+    mp ^= mp << 32;
+    const uint64_t mv = mp & mask;
+    moves[i] = mv;
+    mask = (mask ^ mv) | (mv >> (1u << i));
+    mk &= ~mp;
+  }
+  return moves;
+}
+}  // namespace impl
+
+// Gathers bits of |x| selected by |mask| into the low bits of the
+// result, same as the PEXT instruction. Takes O(log 64) steps, each
+// moving all bits by the same power of two.
+inline constexpr uint64_t PextBroadword(uint64_t x, uint64_t mask) noexcept {
+  const auto moves = impl::CompressMoves(mask);
+  x &= mask;
+  for (unsigned i = 0; i < moves.size(); ++i) {
+    const uint64_t t = x & moves[i];
+    x = (x ^ t) | (t >> (1u << i));
+  }
+  return x;
+}
+
+// Scatters low bits of |x| to positions of ones in |mask|, same as
+// the PDEP instruction. Runs steps of PextBroadword() in reverse.
+inline constexpr uint64_t PdepBroadword(uint64_t x, uint64_t mask) noexcept {
+  const auto moves = impl::CompressMoves(mask);
+  for (unsigned i = moves.size(); i-- > 0;) {
+    const uint64_t t = x << (1u << i);
+    x = (x & ~moves[i]) | (t & moves[i]);
+  }
+  return x & mask;
+}
+
+// Same as PextBroadword(), but uses PEXT when BMI2 is available.
+inline constexpr uint64_t Pext(uint64_t x, uint64_t mask) noexcept {
+#if defined(__BMI2__)
+  if (!std::is_constant_evaluated())
+    return _pext_u64(x, mask);
+#endif
+  return PextBroadword(x, mask);
+}
+
+// Same as PdepBroadword(), but uses PDEP when BMI2 is available.
+inline constexpr uint64_t Pdep(uint64_t x, uint64_t mask) noexcept {
+#if defined(__BMI2__)
+  if (!std::is_constant_evaluated())
+    return _pdep_u64(x, mask);
+#endif
+  return PdepBroadword(x, mask);
+}
+
+namespace impl {
+// Spreads low 32 bits of |x| to even positions.
+inline constexpr uint64_t Spread2(uint64_t x) noexcept {
+#if defined(__BMI2__)
+  if (!std::is_constant_evaluated())
+    return _pdep_u64(x, L(2));
+#endif
+  x &= 0xFFFFFFFF;
+  x = (x | (x << 16)) & 0x0000FFFF0000FFFF;
+  x = (x | (x << 8)) & 0x00FF00FF00FF00FF;
+  x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0F;
+  x = (x | (x << 2)) & 0x3333333333333333;
+  x = (x | (x << 1)) & L(2);
+  return x;
+}
+
+// Inverse of Spread2(), ignores odd bits of |x|.
+inline constexpr uint32_t Compact2(uint64_t x) noexcept {
+#if defined(__BMI2__)
+  if (!std::is_constant_evaluated())
+    return _pext_u64(x, L(2));
+#endif
+  x &= L(2);
+  x = (x | (x >> 1)) & 0x3333333333333333;
+  x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0F;
+  x = (x | (x >> 4)) & 0x00FF00FF00FF00FF;
+  x = (x | (x >> 8)) & 0x0000FFFF0000FFFF;
+  x = (x | (x >> 16)) & 0x00000000FFFFFFFF;
+  return x;
+}
+
+// Positions divisible by 3, except 63.
+inline constexpr uint64_t MORTON3_MASK = L(3) & ~H(64);
+
+// Spreads low 21 bits of |x| to positions divisible by 3.
+inline constexpr uint64_t Spread3(uint64_t x) noexcept {
+#if defined(__BMI2__)
+  if (!std::is_constant_evaluated())
+    return _pdep_u64(x, MORTON3_MASK);
+#endif
+  x &= 0x1FFFFF;
+  x = (x | (x << 32)) & 0x001F00000000FFFF;
+  x = (x | (x << 16)) & 0x001F0000FF0000FF;
+  x = (x | (x << 8)) & 0x100F00F00F00F00F;
+  x = (x | (x << 4)) & 0x10C30C30C30C30C3;
+  x = (x | (x << 2)) & MORTON3_MASK;
+  return x;
+}
+
+// Inverse of Spread3(), ignores bits of |x| on other positions.
+inline constexpr uint32_t Compact3(uint64_t x) noexcept {
+#if defined(__BMI2__)
+  if (!std::is_constant_evaluated())
+    return _pext_u64(x, MORTON3_MASK);
+#endif
+  x &= MORTON3_MASK;
+  x = (x | (x >> 2)) & 0x10C30C30C30C30C3;
+  x = (x | (x >> 4)) & 0x100F00F00F00F00F;
+  x = (x | (x >> 8)) & 0x001F0000FF0000FF;
+  x = (x | (x >> 16)) & 0x001F00000000FFFF;
+  x = (x | (x >> 32)) & 0x00000000001FFFFF;
+  return x;
+}
+}  // namespace impl
+
+// Interleaves bits of |x| and |y| into a 2D Morton (Z-order) code, |x|
+// goes to even bits.
+inline constexpr uint64_t Morton2Encode(uint32_t x, uint32_t y) noexcept {
+  return impl::Spread2(x) | (impl::Spread2(y) << 1);
+}
+
+// Inverse of Morton2Encode(), returns {x, y}.
+inline constexpr std::array<uint32_t, 2> Morton2Decode(uint64_t code) noexcept {
+  return {impl::Compact2(code), impl::Compact2(code >> 1)};
+}
+
+// Interleaves low 21 bits of |x|, |y| and |z| into a 3D Morton code,
+// |x| goes to bits divisible by 3.
+inline constexpr uint64_t Morton3Encode(uint32_t x, uint32_t y, uint32_t z) noexcept {
+  assert(x < (1 << 21) && y < (1 << 21) && z < (1 << 21));
+  return impl::Spread3(x) | (impl::Spread3(y) << 1) | (impl::Spread3(z) << 2);
+}
+
+// Inverse of Morton3Encode(), returns {x, y, z}.
+inline constexpr std::array<uint32_t, 3> Morton3Decode(uint64_t code) noexcept {
+  return {impl::Compact3(code), impl::Compact3(code >> 1), impl::Compact3(code >> 2)};
+}
 }  // namespace algo
@@ -2,6 +2,29 @@
 
 #include "bits/bits.h"
 
+#include <cstdint>
+#include <random>
+
+namespace {
+uint64_t NaivePext(uint64_t x, uint64_t mask) {
+  uint64_t result = 0;
+  for (unsigned i = 0, j = 0; i < 64; ++i) {
+    if ((mask >> i) & 1)
+      result |= ((x >> i) & 1) << j++;
+  }
+  return result;
+}
+
+uint64_t NaivePdep(uint64_t x, uint64_t mask) {
+  uint64_t result = 0;
+  for (unsigned i = 0, j = 0; i < 64; ++i) {
+    if ((mask >> i) & 1)
+      result |= ((x >> j++) & 1) << i;
+  }
+  return result;
+}
+}  // namespace
+
 namespace algo {
 TEST(Bits, L) {
   ASSERT_EQ(0xFFFFFFFFFFFFFFFF, L(1));
@@ -44,4 +67,89 @@ TEST(Bits, HiPos) {
   ASSERT_EQ(static_cast<uint8_t>(31), HiPos(0xFFFFFFFF));
   ASSERT_EQ(static_cast<uint8_t>(63), HiPos(0xFFFFFFFFFFFFFFFF));
 }
+
+TEST(Bits, SelectInWord) {
+  static_assert(SelectInWord(0x1, 0) == 0);
+  static_assert(SelectInWord(0x8000000000000001, 1) == 63);
+
+  ASSERT_EQ(static_cast<uint8_t>(0), SelectInWord(0x1, 0));
+  ASSERT_EQ(static_cast<uint8_t>(3), SelectInWord(0x8, 0));
+  ASSERT_EQ(static_cast<uint8_t>(63), SelectInWord(0x8000000000000000, 0));
+  ASSERT_EQ(static_cast<uint8_t>(5), SelectInWord(0b101010, 2));
+
+  for (uint8_t k = 0; k < 64; ++k)
+    ASSERT_EQ(k, SelectInWord(0xFFFFFFFFFFFFFFFF, k));
+  for (uint8_t k = 0; k < 32; ++k) {
+    ASSERT_EQ(2 * k, SelectInWord(L(2), k));
+    ASSERT_EQ(2 * k + 1, SelectInWord(H(2), k));
+  }
+
+  uint64_t x = 0x9E3779B97F4A7C15;
+  for (int i = 0; i < 1000; ++i) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+
+    uint8_t k = 0;
+    for (uint8_t pos = 0; pos < 64; ++pos) {
+      if ((x >> pos) & 1) {
+        ASSERT_EQ(pos, SelectInWord(x, k++));
+      }
+    }
+  }
+}
+
+TEST(Bits, PopCountBytes) {
+  static_assert(PopCountBytes(0xFF0F030100000080) == 0x0804020100000001);
+  ASSERT_EQ(0u, PopCountBytes(0));
+  ASSERT_EQ(L(8) * 8, PopCountBytes(0xFFFFFFFFFFFFFFFF));
+  ASSERT_EQ(L(8) * 4, PopCountBytes(L(2)));
+}
+
+TEST(Bits, PdepPext) {
+  static_assert(Pext(0b110110, 0b101010) == 0b101);
+  static_assert(Pdep(0b101, 0b101010) == 0b100010);
+
+  std::mt19937_64 engine(0 /* seed */);
+  for (int i = 0; i < 10000; ++i) {
+    const auto x = engine();
+    auto mask = engine();
+    if (i % 3 == 0)
+      mask &= engine();
+    if (i % 5 == 0)
+      mask |= engine();
+
+    ASSERT_EQ(NaivePext(x, mask), PextBroadword(x, mask));
+    ASSERT_EQ(NaivePext(x, mask), Pext(x, mask));
+    ASSERT_EQ(NaivePdep(x, mask), PdepBroadword(x, mask));
+    ASSERT_EQ(NaivePdep(x, mask), Pdep(x, mask));
+  }
+  ASSERT_EQ(0x1234u, Pext(0x1234, 0xFFFF));
+  ASSERT_EQ(0x8000000000000000, Pdep(1, 0x8000000000000000));
+  ASSERT_EQ(0u, Pdep(0xFFFFFFFFFFFFFFFF, 0));
+}
+
+TEST(Bits, Morton) {
+  static_assert(Morton2Encode(0b11, 0b01) == 0b0111);
+  static_assert(Morton3Encode(1, 1, 1) == 0b111);
+
+  std::mt19937_64 engine(0 /* seed */);
+  for (int i = 0; i < 10000; ++i) {
+    const auto x = static_cast<uint32_t>(engine());
+    const auto y = static_cast<uint32_t>(engine());
+    const auto code2 = Morton2Encode(x, y);
+    ASSERT_EQ(NaivePdep(x, L(2)) | NaivePdep(y, H(2)), code2);
+    ASSERT_EQ(x, Morton2Decode(code2)[0]);
+    ASSERT_EQ(y, Morton2Decode(code2)[1]);
+
+    const uint32_t z = x >> 11;
+    const auto code3 = Morton3Encode(x >> 11, y >> 11, z);
+    ASSERT_EQ(NaivePdep(x >> 11, L(3)) | NaivePdep(y >> 11, L(3) << 1) | NaivePdep(z, L(3) << 2), code3);
+    const auto decoded = Morton3Decode(code3);
+    ASSERT_EQ(x >> 11, decoded[0]);
+    ASSERT_EQ(y >> 11, decoded[1]);
+    ASSERT_EQ(z, decoded[2]);
+  }
+  ASSERT_EQ(0x1FFFFFu, Morton3Decode(0xFFFFFFFFFFFFFFFF)[0]);
+}
 }  // namespace algo
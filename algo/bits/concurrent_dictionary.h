@@ -0,0 +1,207 @@
+#pragma once
+
+#include "bits/bits.h"
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <optional>
+
+namespace algo {
+// Thread-safe versions of DictionaryLeaf and Dictionary, built on
+// atomic fetch_or() and fetch_and() over leaf and summary words. All
+// methods may be called concurrently without external locking.
+//
+// Set(), Clear() and Get() are linearizable. A summary bit is set
+// after the bit in the child, and is cleared only when the child is
+// observed empty, after which the child is re-checked until both
+// agree. A child may look empty for a moment while its own summary
+// is being fixed, so Clear() also sets the bit again when the child
+// turns out non-empty. Thus summaries are exact once updates are
+// finished, but may be stale while updates are in flight.
+//
+// Min(), Max(), Pred() and Succ() are exact when there are no
+// concurrent updates. Otherwise they are weaker than linearizable:
+// every returned key was set at some point during the call, and a key
+// that is present during the whole call may be missed only if a
+// subtree containing it is concurrently emptied and refilled.
+struct ConcurrentDictionaryLeaf {
+  // Sets |i|-th bit. Returns true iff the bit was clear.
+  bool Set(uint64_t i) {
+    assert(i < 64);
+    const auto bit = static_cast<uint64_t>(1) << i;
+    // Checks the bit first, so that setting an already set bit does not
+    // take the cache line for writing.
+    if (m_bits.load() & bit)
+      return false;
+    return (m_bits.fetch_or(bit) & bit) == 0;
+  }
+
+  // Clears |i|-th bit. Returns true iff the bit was set.
+  bool Clear(uint64_t i) {
+    assert(i < 64);
+    const auto bit = static_cast<uint64_t>(1) << i;
+    if ((m_bits.load() & bit) == 0)
+      return false;
+    return (m_bits.fetch_and(~bit) & bit) != 0;
+  }
+
+  bool Get(uint64_t i) const {
+    assert(i < 64);
+    return (m_bits.load() >> i) & 1;
+  }
+
+  bool Empty() const { return m_bits.load() == 0; }
+
+  std::optional<uint64_t> Min() const {
+    if (const auto bits = m_bits.load())
+      return LoPosUnsafe(bits);
+    return {};
+  }
+
+  std::optional<uint64_t> Max() const {
+    if (const auto bits = m_bits.load())
+      return HiPosUnsafe(bits);
+    return {};
+  }
+
+  std::optional<uint64_t> Pred(uint64_t i) const {
+    const auto bits = m_bits.load() & ((static_cast<uint64_t>(1) << i) - 1);
+    if (bits == 0)
+      return {};
+    return HiPosUnsafe(bits);
+  }
+
+  std::optional<uint64_t> Succ(uint64_t i) const {
+    auto bits = m_bits.load() >> i;
+    bits >>= 1;
+    if (bits == 0)
+      return {};
+    return LoPosUnsafe(bits) + i + 1;
+  }
+
+  std::atomic<uint64_t> m_bits{};
+};
+
+template <uint64_t LogSize>
+struct ConcurrentDictionary {
+  static_assert(LogSize > 6);
+
+  static constexpr uint64_t POW_NUM_CHILDREN = LogSize % 6 == 0 ? 6 : LogSize % 6;
+  static constexpr uint64_t POW_BLOCK_SIZE = LogSize - POW_NUM_CHILDREN;
+
+  static constexpr uint64_t NUM_CHILDREN = static_cast<uint64_t>(1) << POW_NUM_CHILDREN;
+  static constexpr uint64_t BLOCK_SIZE = static_cast<uint64_t>(1) << POW_BLOCK_SIZE;
+
+  // Sets |i|-th bit. Returns true iff the bit was clear.
+  // Complexity: O(LogSize).
+  bool Set(uint64_t i) {
+    const auto block = i / BLOCK_SIZE;
+    const auto offset = i % BLOCK_SIZE;
+    const bool set = m_children[block].Set(offset);
+    // Done even if the bit was already set, as the summary bit may not
+    // be set yet by a concurrent Set() of the same bit.
+    m_aux.Set(block);
+    return set;
+  }
+
+  // Clears |i|-th bit. Returns true iff the bit was set.
+  // Complexity: O(LogSize).
+  bool Clear(uint64_t i) {
+    const auto block = i / BLOCK_SIZE;
+    const auto offset = i % BLOCK_SIZE;
+    auto& child = m_children[block];
+    if (!child.Clear(offset))
+      return false;
+    // Concurrent Set() and Clear() calls on the child may interleave
+    // with the update of the summary bit, so the child is re-checked
+    // after each update.
+    while (child.Empty()) {
+      m_aux.Clear(block);
+      if (child.Empty())
+        break;
+      m_aux.Set(block);
+    }
+    // The bit may have been cleared by a Clear() of another key, which
+    // saw the child empty while the child's own summary was being
+    // fixed.
+    if (!child.Empty())
+      m_aux.Set(block);
+    return true;
+  }
+
+  // Gets state of the |i|-th bit.
+  // Complexity: O(LogSize).
+  bool Get(uint64_t i) const {
+    const auto block = i / BLOCK_SIZE;
+    const auto offset = i % BLOCK_SIZE;
+    return m_children[block].Get(offset);
+  }
+
+  // Returns true iff the dictionary is empty.
+  // Complexity: O(1).
+  bool Empty() const { return m_aux.Empty(); }
+
+  // Returns min value from the dictionary.
+  // Complexity: O(LogSize) without concurrent updates.
+  std::optional<uint64_t> Min() const { return MinFrom(m_aux.m_bits.load()); }
+
+  // Returns max value from the dictionary.
+  // Complexity: O(LogSize) without concurrent updates.
+  std::optional<uint64_t> Max() const { return MaxFrom(m_aux.m_bits.load()); }
+
+  // Returns rightmost set bit with position less than |i|.
+  // Complexity: O(LogSize * LogSize) without concurrent updates.
+  std::optional<uint64_t> Pred(uint64_t i) const {
+    const auto block = i / BLOCK_SIZE;
+    const auto offset = i % BLOCK_SIZE;
+
+    if (const auto pred = m_children[block].Pred(offset))
+      return *pred + block * BLOCK_SIZE;
+
+    return MaxFrom(m_aux.m_bits.load() & ((static_cast<uint64_t>(1) << block) - 1));
+  }
+
+  // Returns leftmost set bit with position greater than |i|.
+  // Complexity: O(LogSize * LogSize) without concurrent updates.
+  std::optional<uint64_t> Succ(uint64_t i) const {
+    const auto block = i / BLOCK_SIZE;
+    const auto offset = i % BLOCK_SIZE;
+
+    if (const auto succ = m_children[block].Succ(offset))
+      return *succ + block * BLOCK_SIZE;
+
+    return MinFrom(m_aux.m_bits.load() & ~((static_cast<uint64_t>(2) << block) - 1));
+  }
+
+  // Returns min value from children marked in |blocks|, skipping
+  // children that turn out to be empty.
+  std::optional<uint64_t> MinFrom(uint64_t blocks) const {
+    for (; blocks != 0; blocks &= blocks - 1) {
+      const uint64_t block = LoPosUnsafe(blocks);
+      if (const auto min = m_children[block].Min())
+        return *min + block * BLOCK_SIZE;
+    }
+    return {};
+  }
+
+  // Returns max value from children marked in |blocks|, skipping
+  // children that turn out to be empty.
+  std::optional<uint64_t> MaxFrom(uint64_t blocks) const {
+    while (blocks != 0) {
+      const uint64_t block = HiPosUnsafe(blocks);
+      if (const auto max = m_children[block].Max())
+        return *max + block * BLOCK_SIZE;
+      blocks ^= static_cast<uint64_t>(1) << block;
+    }
+    return {};
+  }
+
+  std::array<ConcurrentDictionary<POW_BLOCK_SIZE>, NUM_CHILDREN> m_children;
+  ConcurrentDictionaryLeaf m_aux;
+};
+
+template <>
+struct ConcurrentDictionary<6> : public ConcurrentDictionaryLeaf {};
+}  // namespace algo
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include "bits/concurrent_dictionary.h"
+#include "bits/dictionary.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace algo {
+TEST(Bits, ConcurrentDictionary) {
+  std::mt19937_64 engine(0 /* seed */);
+  Dictionary<16> expected;
+  ConcurrentDictionary<16> dict;
+  for (int i = 0; i < 10000; ++i) {
+    const auto key = engine() % (1 << 16);
+    if (engine() % 3 == 0) {
+      ASSERT_EQ(expected.Get(key), dict.Clear(key));
+      expected.Clear(key);
+    } else {
+      ASSERT_EQ(!expected.Get(key), dict.Set(key));
+      expected.Set(key);
+    }
+
+    const auto query = engine() % (1 << 16);
+    ASSERT_EQ(expected.Get(query), dict.Get(query));
+    ASSERT_EQ(expected.Succ(query), dict.Succ(query));
+    ASSERT_EQ(expected.Pred(query), dict.Pred(query));
+    ASSERT_EQ(expected.Min(), dict.Min());
+    ASSERT_EQ(expected.Max(), dict.Max());
+    ASSERT_EQ(expected.Empty(), dict.Empty());
+  }
+}
+
+TEST(Bits, ConcurrentDictionaryThreads) {
+  constexpr uint64_t kNumThreads = 4;
+  constexpr uint64_t kSize = 1 << 18;
+  const auto dict = std::make_unique<ConcurrentDictionary<18>>();
+
+  // Each thread toggles keys with its own residue, leaving them set in
+  // the end, while readers only check that Succ() never skips
+  // permanent keys, which are set before and never touched.
+  constexpr uint64_t kStride = 4096;
+  for (uint64_t key = 0; key < kSize; key += kStride)
+    dict->Set(key);
+
+  std::atomic<bool> done{false};
+  std::atomic<uint64_t> errors{0};
+  std::thread reader([&]() {
+    std::mt19937_64 engine(0 /* seed */);
+    while (!done.load()) {
+      const auto query = engine() % (kSize - kStride);
+      const auto succ = dict->Succ(query);
+      const auto bound = (query / kStride + 1) * kStride;
+      if (!succ || *succ <= query || *succ > bound)
+        errors.fetch_add(1);
+    }
+  });
+
+  std::vector<std::thread> writers;
+  for (uint64_t t = 0; t < kNumThreads; ++t) {
+    writers.emplace_back([&, t]() {
+      for (int round = 0; round < 3; ++round) {
+        for (uint64_t key = t; key < kSize; key += kNumThreads) {
+          if (key % kStride == 0)
+            continue;
+          if (round % 2 == 0)
+            dict->Set(key);
+          else
+            dict->Clear(key);
+        }
+      }
+    });
+  }
+  for (auto& writer : writers)
+    writer.join();
+  done.store(true);
+  reader.join();
+  ASSERT_EQ(0, errors.load());
+
+  for (uint64_t key = 0; key < kSize; ++key)
+    ASSERT_TRUE(dict->Get(key)) << key;
+  ASSERT_EQ(kSize - 1, dict->Max());
+
+  // Clears everything concurrently, summaries must be exact in the
+  // end.
+  writers.clear();
+  for (uint64_t t = 0; t < kNumThreads; ++t) {
+    writers.emplace_back([&, t]() {
+      for (uint64_t key = t; key < kSize; key += kNumThreads)
+        ASSERT_TRUE(dict->Clear(key));
+    });
+  }
+  for (auto& writer : writers)
+    writer.join();
+  ASSERT_TRUE(dict->Empty());
+  ASSERT_FALSE(dict->Min().has_value());
+}
+
+TEST(Bits, ConcurrentDictionarySummaries) {
+  // Keys are in two leaves of each of two middle nodes, so that
+  // Clear() calls race on summaries of all three levels.
+  std::vector<uint64_t> keys;
+  for (uint64_t top = 0; top < 2; ++top) {
+    for (uint64_t middle = 0; middle < 2; ++middle) {
+      for (uint64_t bit = 0; bit < 2; ++bit)
+        keys.push_back(top * 4096 + middle * 64 + bit);
+    }
+  }
+
+  constexpr uint64_t kNumThreads = 4;
+  const auto dict = std::make_unique<ConcurrentDictionary<18>>();
+  for (int round = 0; round < 50; ++round) {
+    std::vector<std::thread> threads;
+    for (uint64_t t = 0; t < kNumThreads; ++t) {
+      threads.emplace_back([&, t]() {
+        std::mt19937_64 engine(round * kNumThreads + t /* seed */);
+        for (int i = 0; i < 20000; ++i) {
+          const auto key = keys[engine() % keys.size()];
+          if (engine() % 2 == 0)
+            dict->Set(key);
+          else
+            dict->Clear(key);
+        }
+      });
+    }
+    for (auto& thread : threads)
+      thread.join();
+
+    // Summaries must be exact once all updates are finished.
+    std::vector<uint64_t> expected;
+    for (const auto key : keys) {
+      if (dict->Get(key))
+        expected.push_back(key);
+    }
+    std::vector<uint64_t> actual;
+    for (auto key = dict->Min(); key; key = dict->Succ(*key))
+      actual.push_back(*key);
+    ASSERT_EQ(expected.empty(), dict->Empty());
+    ASSERT_EQ(expected, actual);
+  }
+}
+}  // namespace algo
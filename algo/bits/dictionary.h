@@ -2,21 +2,51 @@
 
 #include "bits/bits.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstdint>
+#include <numeric>
 #include <optional>
+#include <span>
+#include <type_traits>
 
 namespace algo {
+namespace impl {
+// Returns mask of bits in [|from|, |to|), where |from| < |to| <= 64.
+inline uint64_t RangeMask(uint64_t from, uint64_t to) {
+  assert(from < to && to <= 64);
+  return (~static_cast<uint64_t>(0) >> (64 - to)) & (~static_cast<uint64_t>(0) << from);
+}
+
+struct NoCounts {};
+}  // namespace impl
+
 struct DictionaryLeaf {
-  void Set(uint64_t i) {
+  static constexpr uint64_t SIZE = 64;
+
+  DictionaryLeaf() = default;
+
+  explicit DictionaryLeaf(std::span<const uint64_t> keys) {
+    assert(std::is_sorted(keys.begin(), keys.end()));
+    [[maybe_unused]] const auto it = SetSorted(keys.data(), keys.data() + keys.size(), 0 /* base */);
+    assert(it == keys.data() + keys.size());
+  }
+
+  // Sets |i|-th bit. Returns true iff the bit was clear.
+  bool Set(uint64_t i) {
     assert(i < 64);
+    const auto bits = m_bits;
     m_bits = m_bits | (static_cast<uint64_t>(1) << i);
+    return bits != m_bits;
   }
 
-  void Clear(uint64_t i) {
+  // Clears |i|-th bit. Returns true iff the bit was set.
+  bool Clear(uint64_t i) {
     assert(i < 64);
+    const auto bits = m_bits;
     m_bits = m_bits & ~(static_cast<uint64_t>(1) << i);
+    return bits != m_bits;
   }
 
   bool Get(uint64_t i) const {
@@ -53,10 +83,60 @@ struct DictionaryLeaf {
     return LoPosUnsafe(bits) + i + 1;
   }
 
+  uint64_t Count() const { return PopCount(m_bits); }
+
+  // Returns number of set bits with positions less than |i|.
+  uint64_t Rank(uint64_t i) const {
+    assert(i <= 64);
+    return i == 64 ? Count() : PopCount(m_bits & ((static_cast<uint64_t>(1) << i) - 1));
+  }
+
+  // Returns position of the |k|-th (0-based) set bit, if any.
+  std::optional<uint64_t> Select(uint64_t k) const {
+    if (k >= Count())
+      return {};
+    return SelectInWord(m_bits, k);
+  }
+
+  // Sets keys from the sorted range [|it|, |end|) that are less than
+  // |base| + SIZE, as offsets from |base|. Returns pointer past the
+  // last consumed key.
+  const uint64_t* SetSorted(const uint64_t* it, const uint64_t* end, uint64_t base) {
+    for (; it != end && *it - base < SIZE; ++it)
+      m_bits |= static_cast<uint64_t>(1) << (*it - base);
+    return it;
+  }
+
+  // Calls |fn| with |base| + i for all set bits i in [|from|, |to|)
+  // in increasing order.
+  template <typename Fn>
+  void ForEach(uint64_t from, uint64_t to, uint64_t base, Fn& fn) const {
+    if (from >= to)
+      return;
+    for (auto bits = m_bits & impl::RangeMask(from, to); bits != 0; bits &= bits - 1)
+      fn(base + LoPosUnsafe(bits));
+  }
+
+  // Same as ForEach(), but in decreasing order.
+  template <typename Fn>
+  void ForEachReverse(uint64_t from, uint64_t to, uint64_t base, Fn& fn) const {
+    if (from >= to)
+      return;
+    for (auto bits = m_bits & impl::RangeMask(from, to); bits != 0;) {
+      const auto i = HiPosUnsafe(bits);
+      fn(base + i);
+      bits ^= static_cast<uint64_t>(1) << i;
+    }
+  }
+
   uint64_t m_bits{};
 };
 
-template <uint64_t LogSize>
+// Bitset over [0, 2^LogSize) with fast successor queries. When
+// |WithCounts| is true, each node additionally keeps cardinalities of
+// its children, which gives Rank(), Count() and Select(). Otherwise
+// counters take no space.
+template <uint64_t LogSize, bool WithCounts = false>
 struct Dictionary {
   static_assert(LogSize > 6);
 
@@ -65,24 +145,43 @@ struct Dictionary {
 
   static constexpr uint64_t NUM_CHILDREN = static_cast<uint64_t>(1) << POW_NUM_CHILDREN;
   static constexpr uint64_t BLOCK_SIZE = static_cast<uint64_t>(1) << POW_BLOCK_SIZE;
+  static constexpr uint64_t SIZE = NUM_CHILDREN * BLOCK_SIZE;
+
+  Dictionary() = default;
 
-  // Sets |i|-th bit.
+  // Builds dictionary from sorted |keys|. Leaf words are filled
+  // directly in a single pass over |keys|, and summaries are set
+  // bottom-up once per touched child.
+  // Complexity: O(|keys| + number of touched leaves).
+  explicit Dictionary(std::span<const uint64_t> keys) {
+    assert(std::is_sorted(keys.begin(), keys.end()));
+    [[maybe_unused]] const auto it = SetSorted(keys.data(), keys.data() + keys.size(), 0 /* base */);
+    assert(it == keys.data() + keys.size());
+  }
+
+  // Sets |i|-th bit. Returns true iff the bit was clear.
   // Complexity: O(LogSize).
-  void Set(uint64_t i) {
+  bool Set(uint64_t i) {
     const auto block = i / BLOCK_SIZE;
     const auto offset = i % BLOCK_SIZE;
-    m_children[block].Set(offset);
+    const bool changed = m_children[block].Set(offset);
     m_aux.Set(block);
+    if constexpr (WithCounts)
+      m_counts[block] += changed;
+    return changed;
   }
 
-  // Clears |i|-th bit.
+  // Clears |i|-th bit. Returns true iff the bit was set.
   // Complexity: O(LogSize).
-  void Clear(uint64_t i) {
+  bool Clear(uint64_t i) {
     const auto block = i / BLOCK_SIZE;
     const auto offset = i % BLOCK_SIZE;
-    m_children[block].Clear(offset);
+    const bool changed = m_children[block].Clear(offset);
     if (m_children[block].Empty())
       m_aux.Clear(block);
+    if constexpr (WithCounts)
+      m_counts[block] -= changed;
+    return changed;
   }
 
   // Gets state of the |i|-th bit.
@@ -143,10 +242,147 @@ struct Dictionary {
     return {};
   }
 
-  std::array<Dictionary<POW_BLOCK_SIZE>, NUM_CHILDREN> m_children;
+  // Returns number of set bits.
+  // Complexity: O(NUM_CHILDREN).
+  uint64_t Count() const
+    requires WithCounts
+  {
+    return std::accumulate(m_counts.begin(), m_counts.end(), static_cast<uint64_t>(0));
+  }
+
+  // Returns number of set bits with positions less than |i|.
+  // Complexity: O(LogSize), with a sum of up to 64 counters per level.
+  uint64_t Rank(uint64_t i) const
+    requires WithCounts
+  {
+    assert(i <= SIZE);
+    if (i == SIZE)
+      return Count();
+    const auto block = i / BLOCK_SIZE;
+    const auto offset = i % BLOCK_SIZE;
+    return std::accumulate(m_counts.begin(), m_counts.begin() + block, static_cast<uint64_t>(0)) +
+           m_children[block].Rank(offset);
+  }
+
+  // Returns position of the |k|-th (0-based) set bit, if any.
+  // Complexity: O(LogSize), with a scan of up to 64 counters per level.
+  std::optional<uint64_t> Select(uint64_t k) const
+    requires WithCounts
+  {
+    for (uint64_t block = 0; block < NUM_CHILDREN; ++block) {
+      if (k < m_counts[block])
+        return *m_children[block].Select(k) + block * BLOCK_SIZE;
+      k -= m_counts[block];
+    }
+    return {};
+  }
+
+  // Calls |fn| for all set bits in [|from|, |to|) in increasing
+  // order. Empty children are skipped via summaries, so enumeration
+  // walks leaf words in order.
+  // Complexity: O(number of set bits + number of touched leaves * LogSize).
+  template <typename Fn>
+  void ForEach(uint64_t from, uint64_t to, Fn&& fn) const {
+    ForEach(from, to, 0 /* base */, fn);
+  }
+
+  // Same as ForEach(), but in decreasing order.
+  template <typename Fn>
+  void ForEachReverse(uint64_t from, uint64_t to, Fn&& fn) const {
+    ForEachReverse(from, to, 0 /* base */, fn);
+  }
+
+  // Sets keys from the sorted range [|it|, |end|) that are less than
+  // |base| + SIZE, as offsets from |base|. Returns pointer past the
+  // last consumed key.
+  const uint64_t* SetSorted(const uint64_t* it, const uint64_t* end, uint64_t base) {
+    if constexpr (POW_BLOCK_SIZE == 6) {
+      // Children are leaves, so keys are set without recursion. This
+      // avoids a hard-to-predict loop exit per leaf when leaves hold
+      // just a few keys each.
+      for (; it != end && *it - base < SIZE; ++it) {
+        const auto offset = *it - base;
+        auto& bits = m_children[offset / 64].m_bits;
+        const auto bit = static_cast<uint64_t>(1) << (offset % 64);
+        if constexpr (WithCounts)
+          m_counts[offset / 64] += (bits & bit) == 0;
+        bits |= bit;
+        m_aux.m_bits |= static_cast<uint64_t>(1) << (offset / 64);
+      }
+      return it;
+    }
+
+    while (it != end && *it - base < SIZE) {
+      const auto block = (*it - base) / BLOCK_SIZE;
+      it = m_children[block].SetSorted(it, end, base + block * BLOCK_SIZE);
+      m_aux.Set(block);
+      if constexpr (WithCounts)
+        m_counts[block] = m_children[block].Count();
+    }
+    return it;
+  }
+
+  // Calls |fn| with |base| + i for all set bits i in [|from|, |to|)
+  // in increasing order.
+  template <typename Fn>
+  void ForEach(uint64_t from, uint64_t to, uint64_t base, Fn& fn) const {
+    assert(to <= SIZE);
+    if (from >= to)
+      return;
+    const auto first = from / BLOCK_SIZE;
+    const auto last = (to - 1) / BLOCK_SIZE;
+    for (auto blocks = m_aux.m_bits & impl::RangeMask(first, last + 1); blocks != 0; blocks &= blocks - 1) {
+      const uint64_t block = LoPosUnsafe(blocks);
+      const uint64_t childFrom = block == first ? from % BLOCK_SIZE : 0;
+      const uint64_t childTo = block == last ? (to - 1) % BLOCK_SIZE + 1 : BLOCK_SIZE;
+      m_children[block].ForEach(childFrom, childTo, base + block * BLOCK_SIZE, fn);
+    }
+  }
+
+  // Same as ForEach(), but in decreasing order.
+  template <typename Fn>
+  void ForEachReverse(uint64_t from, uint64_t to, uint64_t base, Fn& fn) const {
+    assert(to <= SIZE);
+    if (from >= to)
+      return;
+    const auto first = from / BLOCK_SIZE;
+    const auto last = (to - 1) / BLOCK_SIZE;
+    for (auto blocks = m_aux.m_bits & impl::RangeMask(first, last + 1); blocks != 0;) {
+      const uint64_t block = HiPosUnsafe(blocks);
+      const uint64_t childFrom = block == first ? from % BLOCK_SIZE : 0;
+      const uint64_t childTo = block == last ? (to - 1) % BLOCK_SIZE + 1 : BLOCK_SIZE;
+      m_children[block].ForEachReverse(childFrom, childTo, base + block * BLOCK_SIZE, fn);
+      blocks ^= static_cast<uint64_t>(1) << block;
+    }
+  }
+
+  // Children may hold up to BLOCK_SIZE keys.
+  using Counter = std::conditional_t<(POW_BLOCK_SIZE < 32), uint32_t, uint64_t>;
+
+  std::array<Dictionary<POW_BLOCK_SIZE, WithCounts>, NUM_CHILDREN> m_children;
   DictionaryLeaf m_aux;
+
+  // Number of set bits in each child.
+  [[no_unique_address]] std::conditional_t<WithCounts, std::array<Counter, NUM_CHILDREN>, impl::NoCounts> m_counts{};
 };
 
-template <>
-struct Dictionary<6> : public DictionaryLeaf {};
+template <bool WithCounts>
+struct Dictionary<6, WithCounts> : public DictionaryLeaf {
+  using DictionaryLeaf::DictionaryLeaf;
+
+  // Calls |fn| for all set bits in [|from|, |to|) in increasing order.
+  template <typename Fn>
+  void ForEach(uint64_t from, uint64_t to, Fn&& fn) const {
+    DictionaryLeaf::ForEach(from, to, 0 /* base */, fn);
+  }
+
+  // Same as ForEach(), but in decreasing order.
+  template <typename Fn>
+  void ForEachReverse(uint64_t from, uint64_t to, Fn&& fn) const {
+    DictionaryLeaf::ForEachReverse(from, to, 0 /* base */, fn);
+  }
+
+  using DictionaryLeaf::ForEach;
+  using DictionaryLeaf::ForEachReverse;
+};
 }  // namespace algo
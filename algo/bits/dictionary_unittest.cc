@@ -2,6 +2,12 @@
 
 #include "bits/dictionary.h"
 
+#include <iterator>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
 namespace algo {
 TEST(Bits, DictionaryLeaf) {
   DictionaryLeaf dict;
@@ -88,4 +94,105 @@ TEST(Bits, Dictionary) {
   ASSERT_EQ(dict.Succ(2), 4);
   ASSERT_EQ(dict.Pred(4), 1);
 }
+
+TEST(Bits, DictionaryBulkBuild) {
+  std::mt19937_64 engine(0 /* seed */);
+  for (const uint64_t mask : {0xFFFF, 0x3F, 0xF00F, 0x1}) {
+    std::set<uint64_t> expected;
+    for (int i = 0; i < 5000; ++i)
+      expected.insert(engine() & mask);
+    const std::vector<uint64_t> keys(expected.begin(), expected.end());
+
+    const auto dict = std::make_unique<Dictionary<16>>(keys);
+    Dictionary<16> reference;
+    for (const auto key : keys)
+      reference.Set(key);
+
+    for (uint64_t i = 0; i < Dictionary<16>::SIZE; i += 7) {
+      ASSERT_EQ(reference.Get(i), dict->Get(i));
+      ASSERT_EQ(reference.Succ(i), dict->Succ(i));
+      ASSERT_EQ(reference.Pred(i), dict->Pred(i));
+    }
+    ASSERT_EQ(reference.Min(), dict->Min());
+    ASSERT_EQ(reference.Max(), dict->Max());
+  }
+
+  const Dictionary<6> leaf(std::vector<uint64_t>{1, 5, 63});
+  ASSERT_TRUE(leaf.Get(5));
+  ASSERT_EQ(leaf.Max(), 63);
+}
+
+TEST(Bits, DictionaryForEach) {
+  std::mt19937_64 engine(0 /* seed */);
+  std::set<uint64_t> expected;
+  for (int i = 0; i < 3000; ++i)
+    expected.insert(engine() % 40000);
+  const std::vector<uint64_t> keys(expected.begin(), expected.end());
+  const Dictionary<16> dict(keys);
+
+  for (int test = 0; test < 200; ++test) {
+    uint64_t from = engine() % (Dictionary<16>::SIZE + 1);
+    uint64_t to = engine() % (Dictionary<16>::SIZE + 1);
+    if (from > to)
+      std::swap(from, to);
+    if (test == 0) {
+      from = 0;
+      to = Dictionary<16>::SIZE;
+    }
+
+    const std::vector<uint64_t> forward(expected.lower_bound(from), expected.lower_bound(to));
+    std::vector<uint64_t> actual;
+    dict.ForEach(from, to, [&](uint64_t i) { actual.push_back(i); });
+    ASSERT_EQ(forward, actual);
+
+    actual.clear();
+    dict.ForEachReverse(from, to, [&](uint64_t i) { actual.push_back(i); });
+    ASSERT_EQ(std::vector<uint64_t>(forward.rbegin(), forward.rend()), actual);
+  }
+
+  Dictionary<6> leaf;
+  leaf.Set(0);
+  leaf.Set(10);
+  leaf.Set(63);
+  std::vector<uint64_t> actual;
+  leaf.ForEach(0, 64, [&](uint64_t i) { actual.push_back(i); });
+  ASSERT_EQ(std::vector<uint64_t>({0, 10, 63}), actual);
+  actual.clear();
+  leaf.ForEachReverse(1, 63, [&](uint64_t i) { actual.push_back(i); });
+  ASSERT_EQ(std::vector<uint64_t>({10}), actual);
+}
+
+TEST(Bits, DictionaryWithCounts) {
+  static_assert(sizeof(Dictionary<18>) < sizeof(Dictionary<18, true>));
+  static_assert(sizeof(Dictionary<12>) == 65 * sizeof(uint64_t));
+
+  std::mt19937_64 engine(0 /* seed */);
+  const auto dict = std::make_unique<Dictionary<18, true>>();
+  std::set<uint64_t> expected;
+  for (int i = 0; i < 20000; ++i) {
+    const auto key = engine() % Dictionary<18>::SIZE;
+    if (engine() % 3 == 0) {
+      ASSERT_EQ(expected.erase(key) != 0, dict->Clear(key));
+    } else {
+      ASSERT_EQ(expected.insert(key).second, dict->Set(key));
+    }
+    ASSERT_EQ(expected.size(), dict->Count());
+
+    const auto query = engine() % (Dictionary<18>::SIZE + 1);
+    const auto rank = std::distance(expected.begin(), expected.lower_bound(query));
+    ASSERT_EQ(rank, dict->Rank(query));
+    if (rank < static_cast<int64_t>(expected.size())) {
+      ASSERT_EQ(*expected.lower_bound(query), dict->Select(rank));
+    }
+  }
+  ASSERT_FALSE(dict->Select(expected.size()).has_value());
+
+  const std::vector<uint64_t> keys(expected.begin(), expected.end());
+  const auto bulk = std::make_unique<Dictionary<18, true>>(keys);
+  ASSERT_EQ(keys.size(), bulk->Count());
+  for (size_t k = 0; k < keys.size(); k += 17) {
+    ASSERT_EQ(keys[k], bulk->Select(k));
+    ASSERT_EQ(k, bulk->Rank(keys[k]));
+  }
+}
 }  // namespace algo
@@ -0,0 +1,74 @@
+#include "bits/elias_fano.h"
+
+#include "bits/bits.h"
+
+#include <vector>
+
+namespace algo {
+namespace {
+uint8_t NumLowBits(uint64_t numBits, uint64_t numOnes) {
+  if (numOnes == 0 || numBits <= numOnes)
+    return 0;
+  return HiPosUnsafe(numBits / numOnes);
+}
+
+BitVector Lower(std::span<const uint64_t> positions, uint8_t numLowBits) {
+  BitVector lower(positions.size() * numLowBits);
+  for (uint64_t i = 0; i < positions.size(); ++i)
+    lower.SetBits(i * numLowBits, numLowBits, positions[i]);
+  return lower;
+}
+
+BitVector Upper(uint64_t numBits, std::span<const uint64_t> positions, uint8_t numLowBits) {
+  BitVector upper(positions.size() + (numBits >> numLowBits) + 1);
+  for (uint64_t i = 0; i < positions.size(); ++i) {
+    assert(positions[i] < numBits);
+    assert(i == 0 || positions[i - 1] < positions[i]);
+    upper.Set((positions[i] >> numLowBits) + i);
+  }
+  return upper;
+}
+
+std::vector<uint64_t> Positions(const BitVector& bv) {
+  std::vector<uint64_t> positions;
+  for (uint64_t i = 0; i < bv.NumBits(); ++i) {
+    if (bv.Test(i))
+      positions.push_back(i);
+  }
+  return positions;
+}
+}  // namespace
+
+EliasFano::EliasFano(const BitVector& bv) : EliasFano(bv.NumBits(), Positions(bv)) {}
+
+EliasFano::EliasFano(uint64_t numBits, std::span<const uint64_t> positions)
+    : m_numBits{numBits}
+    , m_numOnes{positions.size()}
+    , m_numLowBits{NumLowBits(numBits, positions.size())}
+    , m_lower{Lower(positions, m_numLowBits)}
+    , m_upper{Upper(numBits, positions, m_numLowBits)}
+    , m_upperRS{m_upper} {}
+
+uint64_t EliasFano::Rank1(uint64_t n) const {
+  assert(n <= m_numBits);
+  if (n == m_numBits)
+    return m_numOnes;
+
+  // Ones with high bits less than |high| are before the |high|-th
+  // zero in |m_upper|, ones with the same high bits follow it.
+  const uint64_t high = n >> m_numLowBits;
+  const uint64_t low = n & ((static_cast<uint64_t>(1) << m_numLowBits) - 1);
+
+  uint64_t pos = high == 0 ? 0 : m_upperRS.Select0(high - 1) + 1;
+  uint64_t rank = pos - high;
+  while (rank < m_numOnes && m_upper.Test(pos) && Low(rank) < low) {
+    ++pos;
+    ++rank;
+  }
+  return rank;
+}
+
+uint64_t EliasFano::SizeInBytes() const {
+  return sizeof(*this) + 8 * (m_lower.NumBlocks() + m_upper.NumBlocks()) + m_upperRS.SizeInBytes();
+}
+}  // namespace algo
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "bits/bit_vector.h"
+#include "bits/rs_table.h"
+
+#include <cassert>
+#include <cstdint>
+#include <span>
+
+namespace algo {
+// Elias-Fano encoding of a bit vector, i.e. of a sorted sequence of
+// positions of ones. Each position is split into |m_numLowBits| low
+// bits, stored verbatim, and high bits, stored in unary in
+// |m_upper|. Takes about 2 + log(NumBits() / NumOnes()) bits per one,
+// so it pays off on sparse bit vectors.
+//
+// Select1() is O(1) via RSTable::Select1() over upper bits. Rank1()
+// and Test() additionally scan positions sharing the same high bits,
+// which is a constant number on average.
+class EliasFano {
+public:
+  explicit EliasFano(const BitVector& bv);
+
+  // Builds encoding of a bit vector of |numBits| bits where ones are
+  // at |positions|. |positions| should be strictly increasing.
+  EliasFano(uint64_t numBits, std::span<const uint64_t> positions);
+
+  bool Test(uint64_t bit) const {
+    assert(bit < m_numBits);
+    const uint64_t rank = Rank1(bit);
+    return rank < m_numOnes && Select1(rank) == bit;
+  }
+
+  // Returns number of zeroes among the first |n| bits.
+  uint64_t Rank0(uint64_t n) const { return n - Rank1(n); }
+
+  // Returns number of ones among the first |n| bits.
+  uint64_t Rank1(uint64_t n) const;
+
+  // Returns position of the |k|-th (0-based) one. |k| should be less
+  // than NumOnes().
+  uint64_t Select1(uint64_t k) const {
+    assert(k < m_numOnes);
+    return ((m_upperRS.Select1(k) - k) << m_numLowBits) | Low(k);
+  }
+
+  uint64_t NumBits() const { return m_numBits; }
+  uint64_t NumZeros() const { return m_numBits - m_numOnes; }
+  uint64_t NumOnes() const { return m_numOnes; }
+
+  // Returns total size of the encoding.
+  uint64_t SizeInBytes() const;
+
+private:
+  uint64_t Low(uint64_t k) const { return m_lower.GetBits(k * m_numLowBits, m_numLowBits); }
+
+  uint64_t m_numBits{};
+  uint64_t m_numOnes{};
+  uint8_t m_numLowBits{};
+
+  BitVector m_lower;
+  BitVector m_upper;
+  RSTable m_upperRS;
+};
+}  // namespace algo
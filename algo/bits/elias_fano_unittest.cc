@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include "bits/bit_vector.h"
+#include "bits/elias_fano.h"
+#include "bits/rank_support.h"
+
+#include <random>
+#include <vector>
+
+using namespace algo;
+
+namespace {
+static_assert(RankSupport<EliasFano>);
+
+TEST(Bits, EliasFano_Smoke) {
+  BitVector bv(0);
+  EliasFano encoded(bv);
+  ASSERT_EQ(0, encoded.NumBits());
+  ASSERT_EQ(0, encoded.Rank1(0));
+}
+
+TEST(Bits, EliasFano_Random) {
+  std::mt19937_64 engine(42);
+
+  for (const auto size : {1, 14, 15, 16, 64, 480, 1000, 20000}) {
+    for (const double density : {0.0, 0.001, 0.05, 0.5, 0.95, 1.0}) {
+      std::bernoulli_distribution bit(density);
+
+      BitVector bv(size);
+      std::vector<uint64_t> zeros;
+      std::vector<uint64_t> ones;
+      for (uint64_t i = 0; i < bv.NumBits(); ++i) {
+        if (bit(engine)) {
+          bv.Set(i);
+          ones.push_back(i);
+        } else {
+          zeros.push_back(i);
+        }
+      }
+
+      const EliasFano encoded(bv);
+      ASSERT_EQ(bv.NumBits(), encoded.NumBits());
+      ASSERT_EQ(ones.size(), encoded.NumOnes());
+      ASSERT_EQ(zeros.size(), encoded.NumZeros());
+
+      uint64_t rank = 0;
+      for (uint64_t i = 0; i < bv.NumBits(); ++i) {
+        ASSERT_EQ(rank, encoded.Rank1(i)) << size << " " << density << " " << i;
+        ASSERT_EQ(i - rank, encoded.Rank0(i));
+        ASSERT_EQ(bv.Test(i), encoded.Test(i));
+        rank += bv.Test(i);
+      }
+      ASSERT_EQ(rank, encoded.Rank1(bv.NumBits()));
+
+      for (uint64_t k = 0; k < ones.size(); ++k)
+        ASSERT_EQ(ones[k], encoded.Select1(k));
+    }
+  }
+}
+
+TEST(Bits, EliasFano_Positions) {
+  const std::vector<uint64_t> positions = {0, 5, 6, 7, 100, 1000, 1001, 65535};
+  const EliasFano encoded(1 << 16, positions);
+  ASSERT_EQ(positions.size(), encoded.NumOnes());
+  for (uint64_t k = 0; k < positions.size(); ++k) {
+    ASSERT_EQ(positions[k], encoded.Select1(k));
+    ASSERT_EQ(k, encoded.Rank1(positions[k]));
+    ASSERT_EQ(k + 1, encoded.Rank1(positions[k] + 1));
+    ASSERT_TRUE(encoded.Test(positions[k]));
+  }
+  ASSERT_FALSE(encoded.Test(1));
+  ASSERT_FALSE(encoded.Test(999));
+  ASSERT_EQ(4, encoded.Rank1(100));
+}
+}  // namespace
@@ -0,0 +1,41 @@
+#include "bits/interleaved_rs_table.h"
+
+#include "bits/bits.h"
+
+#include <cassert>
+
+namespace algo {
+InterleavedRSTable::InterleavedRSTable(const BitVector& bv)
+    : m_lines(bv.NumBits() / BITS_PER_LINE + 1), m_numBits(bv.NumBits()) {
+  uint64_t rank = 0;
+  for (uint64_t i = 0; i < m_lines.size(); ++i) {
+    auto& line = m_lines[i];
+    line.m_rank = rank;
+    for (uint64_t j = 0; j < BLOCKS_PER_LINE; ++j) {
+      const uint64_t block = i * BLOCKS_PER_LINE + j;
+      if (block >= bv.NumBlocks())
+        break;
+      line.m_bits[j] = bv.Block(block);
+      rank += PopCount(line.m_bits[j]);
+    }
+  }
+  m_numOnes = rank;
+}
+
+uint64_t InterleavedRSTable::Rank1(uint64_t n) const {
+  assert(n <= m_numBits);
+  const auto& line = m_lines[n / BITS_PER_LINE];
+  const uint64_t offset = n % BITS_PER_LINE;
+  const uint64_t block = offset / 64;
+  const uint64_t mask = (static_cast<uint64_t>(1) << (offset % 64)) - 1;
+
+  // Masks are chosen so that the loop has a fixed trip count and no
+  // data-dependent branches.
+  uint64_t rank = line.m_rank;
+  for (uint64_t i = 0; i < BLOCKS_PER_LINE; ++i) {
+    const uint64_t m = i < block ? ~static_cast<uint64_t>(0) : (i == block ? mask : 0);
+    rank += PopCount(line.m_bits[i] & m);
+  }
+  return rank;
+}
+}  // namespace algo
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "bits/bit_vector.h"
+
+#include <cassert>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+namespace algo {
+// An owning alternative to RSTable. Bits are copied into 64-byte
+// lines, each holding an absolute rank followed by 7 blocks of
+// bits, so a rank query touches exactly one cache line. Ranks inside
+// a line are computed by popcounts of at most 7 blocks, which are
+// already in L1 at that point.
+//
+// Costs 64 bits per 448 bits of data (14.3%) versus 128 bits per 512
+// (25%) of RSTable, but copies the bit vector.
+class InterleavedRSTable {
+public:
+  static_assert(CHAR_BIT == 8, "");
+
+  static constexpr uint64_t BLOCKS_PER_LINE = 7;
+  static constexpr uint64_t BITS_PER_LINE = 64 * BLOCKS_PER_LINE;
+
+  explicit InterleavedRSTable(const BitVector& bv);
+
+  bool Test(uint64_t bit) const {
+    assert(bit < m_numBits);
+    const auto& line = m_lines[bit / BITS_PER_LINE];
+    const uint64_t offset = bit % BITS_PER_LINE;
+    return (line.m_bits[offset / 64] >> (offset % 64)) & 1;
+  }
+
+  // Returns number of zeroes among the first |n| bits.
+  uint64_t Rank0(uint64_t n) const { return n - Rank1(n); }
+
+  // Returns number of ones among the first |n| bits.
+  uint64_t Rank1(uint64_t n) const;
+
+  uint64_t NumBits() const { return m_numBits; }
+  uint64_t NumZeros() const { return m_numBits - m_numOnes; }
+  uint64_t NumOnes() const { return m_numOnes; }
+
+  // Returns total size of the table, including bits.
+  uint64_t SizeInBytes() const { return sizeof(*this) + m_lines.size() * sizeof(Line); }
+
+private:
+  struct alignas(64) Line {
+    // Number of ones before the line.
+    uint64_t m_rank{};
+    uint64_t m_bits[BLOCKS_PER_LINE]{};
+  };
+
+  static_assert(sizeof(Line) == 64, "");
+
+  std::vector<Line> m_lines;
+  uint64_t m_numBits{};
+  uint64_t m_numOnes{};
+};
+}  // namespace algo
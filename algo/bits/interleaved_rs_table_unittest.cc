@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include "bits/bit_vector.h"
+#include "bits/interleaved_rs_table.h"
+#include "bits/rank_support.h"
+#include "bits/rs_table.h"
+
+#include <random>
+
+using namespace algo;
+
+namespace {
+static_assert(RankSupport<RSTable>);
+static_assert(RankSupport<InterleavedRSTable>);
+
+template <RankSupport Table>
+void TestRanks(const BitVector& bv) {
+  const Table table(bv);
+  ASSERT_EQ(bv.NumBits(), table.NumBits());
+
+  uint64_t rank = 0;
+  for (uint64_t i = 0; i < bv.NumBits(); ++i) {
+    ASSERT_EQ(rank, table.Rank1(i));
+    ASSERT_EQ(i - rank, table.Rank0(i));
+    ASSERT_EQ(bv.Test(i), table.Test(i));
+    rank += bv.Test(i);
+  }
+  ASSERT_EQ(rank, table.Rank1(bv.NumBits()));
+  ASSERT_EQ(rank, table.NumOnes());
+  ASSERT_EQ(bv.NumBits() - rank, table.NumZeros());
+}
+
+TEST(Bits, InterleavedRSTable_Smoke) {
+  for (const auto size : {0, 1, 63, 64, 447, 448, 449, 896, 1025}) {
+    BitVector bv(size);
+    TestRanks<InterleavedRSTable>(bv);
+
+    for (uint64_t i = 0; i < bv.NumBits(); ++i)
+      bv.Set(i);
+    TestRanks<InterleavedRSTable>(bv);
+  }
+}
+
+TEST(Bits, InterleavedRSTable_Random) {
+  std::mt19937_64 engine(42);
+
+  BitVector bv(10000);
+  for (uint64_t i = 0; i < bv.NumBits(); ++i) {
+    if (engine() % 3 == 0)
+      bv.Set(i);
+  }
+
+  TestRanks<RSTable>(bv);
+  TestRanks<InterleavedRSTable>(bv);
+}
+}  // namespace
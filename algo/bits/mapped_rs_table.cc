@@ -0,0 +1,133 @@
+#include "bits/mapped_rs_table.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <span>
+#include <utility>
+
+namespace algo {
+namespace {
+constexpr uint64_t ALIGNMENT = 64;
+
+uint64_t Align(uint64_t offset) { return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT; }
+
+template <typename T>
+void WriteSection(std::ofstream& os, std::span<const T> values) {
+  static const char padding[ALIGNMENT] = {};
+  const uint64_t offset = os.tellp();
+  os.write(padding, Align(offset) - offset);
+  os.write(reinterpret_cast<const char*>(values.data()), values.size_bytes());
+}
+
+// Returns a span of |size| values of type T at the next aligned
+// offset of |data|, and advances |offset|. Returns nothing when the
+// section doesn't fit in |dataSize| bytes.
+template <typename T>
+std::optional<std::span<const T>> ReadSection(const char* data, uint64_t dataSize, uint64_t& offset, uint64_t size) {
+  offset = Align(offset);
+  if (offset > dataSize || (dataSize - offset) / sizeof(T) < size)
+    return {};
+  const std::span<const T> values{reinterpret_cast<const T*>(data + offset), size};
+  offset += values.size_bytes();
+  return values;
+}
+
+// Checks that select samples are non-decreasing indices of super
+// blocks, so that selects don't read outside of super blocks.
+bool ValidSelectSamples(std::span<const uint64_t> samples, uint64_t numSuperBlocks) {
+  uint64_t prev = 0;
+  for (const auto sample : samples) {
+    if (sample < prev || sample >= numSuperBlocks)
+      return false;
+    prev = sample;
+  }
+  return true;
+}
+}  // namespace
+
+// static
+bool MappedRSTable::Write(const RSTable& rs, const std::string& path) {
+  Header header;
+  header.m_magic = MAGIC;
+  header.m_version = VERSION;
+  header.m_numBits = rs.m_numBits;
+  header.m_numOnes = rs.m_numOnes;
+  header.m_numBlocks = rs.m_blocks.size();
+  header.m_numSuperBlocks = rs.m_superBlocks.size();
+  header.m_numSelectSamples0 = rs.m_selectSamples0.size();
+  header.m_numSelectSamples1 = rs.m_selectSamples1.size();
+
+  std::ofstream os(path, std::ios::binary | std::ios::trunc);
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  WriteSection(os, rs.m_blocks);
+  WriteSection(os, rs.m_superBlocks);
+  WriteSection(os, rs.m_selectSamples0);
+  WriteSection(os, rs.m_selectSamples1);
+  os.close();
+  return os.good();
+}
+
+// static
+std::optional<MappedRSTable> MappedRSTable::Open(const std::string& path) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return {};
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<uint64_t>(st.st_size) < sizeof(Header)) {
+    close(fd);
+    return {};
+  }
+
+  const size_t size = st.st_size;
+  void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0 /* offset */);
+  close(fd);
+  if (data == MAP_FAILED)
+    return {};
+
+  const char* bytes = static_cast<const char*>(data);
+  const auto& header = *reinterpret_cast<const Header*>(bytes);
+
+  uint64_t offset = sizeof(Header);
+  std::optional<std::span<const uint64_t>> blocks;
+  std::optional<std::span<const RSTable::SuperBlock>> superBlocks;
+  std::optional<std::span<const uint64_t>> selectSamples0;
+  std::optional<std::span<const uint64_t>> selectSamples1;
+
+  // Sections are read in the order they were written, so each one is
+  // checked only when previous ones fit.
+  const auto numSamples = [](uint64_t n) { return (n + RSTable::SELECT_SAMPLE_RATE - 1) / RSTable::SELECT_SAMPLE_RATE + 1; };
+  const bool valid = header.m_magic == MAGIC && header.m_version == VERSION &&
+                     header.m_numOnes <= header.m_numBits && header.m_numBlocks == header.m_numBits / 64 + 1 &&
+                     header.m_numSuperBlocks == header.m_numBlocks / 8 + 1 &&
+                     header.m_numSelectSamples0 == numSamples(header.m_numBits - header.m_numOnes) &&
+                     header.m_numSelectSamples1 == numSamples(header.m_numOnes) &&
+                     (blocks = ReadSection<uint64_t>(bytes, size, offset, header.m_numBlocks)) &&
+                     (superBlocks = ReadSection<RSTable::SuperBlock>(bytes, size, offset, header.m_numSuperBlocks)) &&
+                     (selectSamples0 = ReadSection<uint64_t>(bytes, size, offset, header.m_numSelectSamples0)) &&
+                     (selectSamples1 = ReadSection<uint64_t>(bytes, size, offset, header.m_numSelectSamples1)) &&
+                     ValidSelectSamples(*selectSamples0, header.m_numSuperBlocks) &&
+                     ValidSelectSamples(*selectSamples1, header.m_numSuperBlocks);
+  if (!valid) {
+    munmap(data, size);
+    return {};
+  }
+
+  RSTable table{header.m_numBits, header.m_numOnes, *blocks, *superBlocks, *selectSamples0, *selectSamples1};
+  return MappedRSTable{data, size, std::move(table)};
+}
+
+MappedRSTable::MappedRSTable(MappedRSTable&& rhs) : m_data{rhs.m_data}, m_size{rhs.m_size}, m_table{std::move(rhs.m_table)} {
+  rhs.m_data = nullptr;
+  rhs.m_size = 0;
+}
+
+MappedRSTable::~MappedRSTable() {
+  if (m_data != nullptr)
+    munmap(m_data, m_size);
+}
+}  // namespace algo
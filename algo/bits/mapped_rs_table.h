@@ -0,0 +1,68 @@
+#pragma once
+
+#include "bits/rs_table.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace algo {
+// A read-only RSTable backed by a memory-mapped file. Opening doesn't
+// read or rebuild anything, pages are loaded lazily on first access
+// and are shared between all processes that map the same file.
+//
+// File layout (native byte order, all sections are aligned to 64
+// bytes):
+//
+//   Header
+//   bit vector blocks
+//   super blocks
+//   select samples for zeroes
+//   select samples for ones
+class MappedRSTable {
+public:
+  static constexpr uint64_t MAGIC = 0x4C42545352424C43;  // "CLBRSTBL"
+  static constexpr uint32_t VERSION = 1;
+
+  // Writes |rs| together with bits it was built for to |path|.
+  // Returns false on I/O error.
+  static bool Write(const RSTable& rs, const std::string& path);
+
+  // Maps a file written by Write(). Returns nothing if the file can't
+  // be mapped, its magic, version or size don't match, or its select
+  // samples point outside of super blocks. Other contents are read
+  // lazily and are trusted, so a corrupted file may give wrong
+  // answers.
+  static std::optional<MappedRSTable> Open(const std::string& path);
+
+  MappedRSTable(const MappedRSTable&) = delete;
+  MappedRSTable(MappedRSTable&& rhs);
+
+  MappedRSTable& operator=(const MappedRSTable&) = delete;
+  MappedRSTable& operator=(MappedRSTable&&) = delete;
+
+  ~MappedRSTable();
+
+  const RSTable& Table() const { return m_table; }
+
+private:
+  struct Header {
+    uint64_t m_magic{};
+    uint32_t m_version{};
+    uint32_t m_reserved{};
+    uint64_t m_numBits{};
+    uint64_t m_numOnes{};
+    uint64_t m_numBlocks{};
+    uint64_t m_numSuperBlocks{};
+    uint64_t m_numSelectSamples0{};
+    uint64_t m_numSelectSamples1{};
+  };
+
+  MappedRSTable(void* data, size_t size, RSTable&& table) : m_data{data}, m_size{size}, m_table{std::move(table)} {}
+
+  void* m_data{};
+  size_t m_size{};
+  RSTable m_table;
+};
+}  // namespace algo
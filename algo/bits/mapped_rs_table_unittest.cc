@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include "bits/bit_vector.h"
+#include "bits/mapped_rs_table.h"
+#include "bits/rs_table.h"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+using namespace algo;
+
+namespace {
+class MappedRSTableTest : public testing::Test {
+protected:
+  void TearDown() override { std::filesystem::remove(m_path); }
+
+  const std::string m_path =
+      (std::filesystem::temp_directory_path() / ("mapped_rs_table_" + std::to_string(getpid()))).string();
+};
+
+TEST_F(MappedRSTableTest, Smoke) {
+  std::mt19937_64 engine(42);
+
+  for (const auto size : {0, 1, 64, 511, 512, 100000}) {
+    BitVector bv(size);
+    for (uint64_t i = 0; i < bv.NumBits(); ++i) {
+      if (engine() % 5 == 0)
+        bv.Set(i);
+    }
+
+    const RSTable rs(bv);
+    ASSERT_TRUE(MappedRSTable::Write(rs, m_path));
+
+    const auto mapped = MappedRSTable::Open(m_path);
+    ASSERT_TRUE(mapped.has_value());
+
+    const auto& table = mapped->Table();
+    ASSERT_EQ(rs.NumBits(), table.NumBits());
+    ASSERT_EQ(rs.NumOnes(), table.NumOnes());
+    for (uint64_t i = 0; i < bv.NumBits(); ++i)
+      ASSERT_EQ(bv.Test(i), table.Test(i));
+    for (uint64_t i = 0; i <= bv.NumBits(); ++i)
+      ASSERT_EQ(rs.Rank1(i), table.Rank1(i));
+    for (uint64_t k = 0; k < rs.NumOnes(); ++k)
+      ASSERT_EQ(rs.Select1(k), table.Select1(k));
+    for (uint64_t k = 0; k < rs.NumZeros(); ++k)
+      ASSERT_EQ(rs.Select0(k), table.Select0(k));
+  }
+}
+
+TEST_F(MappedRSTableTest, Invalid) {
+  ASSERT_FALSE(MappedRSTable::Open(m_path).has_value());
+
+  BitVector bv(1000);
+  bv.Set(10);
+  ASSERT_TRUE(MappedRSTable::Write(RSTable(bv), m_path));
+  ASSERT_TRUE(MappedRSTable::Open(m_path).has_value());
+
+  // Last select sample for ones is past the last super block.
+  {
+    std::fstream fs(m_path, std::ios::binary | std::ios::in | std::ios::out);
+    fs.seekp(-static_cast<std::streamoff>(sizeof(uint64_t)), std::ios::end);
+    const uint64_t sample = 1000;
+    fs.write(reinterpret_cast<const char*>(&sample), sizeof(sample));
+  }
+  ASSERT_FALSE(MappedRSTable::Open(m_path).has_value());
+
+  // Truncated file.
+  std::filesystem::resize_file(m_path, std::filesystem::file_size(m_path) - 8);
+  ASSERT_FALSE(MappedRSTable::Open(m_path).has_value());
+
+  // Wrong magic.
+  {
+    std::ofstream os(m_path, std::ios::binary | std::ios::trunc);
+    const std::string garbage(4096, 'x');
+    os << garbage;
+  }
+  ASSERT_FALSE(MappedRSTable::Open(m_path).has_value());
+}
+}  // namespace
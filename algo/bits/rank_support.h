@@ -0,0 +1,20 @@
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+
+namespace algo {
+// Requirements for a bit sequence with rank support, e.g. RSTable
+// or InterleavedRSTable. Code that only needs these queries should be
+// templated on a RankSupport type, so the layout can be chosen by a
+// caller.
+template <typename T>
+concept RankSupport = requires(const T& t, uint64_t n) {
+  { t.Test(n) } -> std::convertible_to<bool>;
+  { t.Rank0(n) } -> std::convertible_to<uint64_t>;
+  { t.Rank1(n) } -> std::convertible_to<uint64_t>;
+  { t.NumBits() } -> std::convertible_to<uint64_t>;
+  { t.NumZeros() } -> std::convertible_to<uint64_t>;
+  { t.NumOnes() } -> std::convertible_to<uint64_t>;
+};
+}  // namespace algo
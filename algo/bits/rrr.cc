@@ -0,0 +1,144 @@
+#include "bits/rrr.h"
+
+#include "bits/bits.h"
+
+#include <algorithm>
+
+namespace algo {
+namespace {
+constexpr uint64_t BLOCK_SIZE = RRR::BLOCK_SIZE;
+
+struct Tables {
+  Tables() {
+    for (uint64_t n = 0; n <= BLOCK_SIZE; ++n) {
+      m_binomials[n][0] = 1;
+      for (uint64_t k = 1; k <= n; ++k)
+        m_binomials[n][k] = m_binomials[n - 1][k - 1] + (k < n ? m_binomials[n - 1][k] : 0);
+    }
+
+    for (uint64_t c = 0; c <= BLOCK_SIZE; ++c) {
+      const uint64_t count = m_binomials[BLOCK_SIZE][c];
+      m_offsetBits[c] = count == 1 ? 0 : HiPosUnsafe(count - 1) + 1;
+      m_starts[c + 1] = m_starts[c] + count;
+    }
+
+    for (uint64_t bits = 0; bits < (static_cast<uint64_t>(1) << BLOCK_SIZE); ++bits)
+      m_decode[m_starts[PopCount(bits)] + Encode(bits)] = bits;
+  }
+
+  // Returns index of |bits| among all blocks of the same class, in
+  // the combinatorial number system.
+  uint64_t Encode(uint64_t bits) const {
+    uint64_t offset = 0;
+    uint64_t k = 1;
+    for (uint64_t p = 0; p < BLOCK_SIZE; ++p) {
+      if ((bits >> p) & 1)
+        offset += m_binomials[p][k++];
+    }
+    return offset;
+  }
+
+  uint64_t m_binomials[BLOCK_SIZE + 1][BLOCK_SIZE + 1]{};
+  uint8_t m_offsetBits[BLOCK_SIZE + 1]{};
+  uint64_t m_starts[BLOCK_SIZE + 2]{};
+  uint16_t m_decode[static_cast<uint64_t>(1) << BLOCK_SIZE]{};
+};
+
+const Tables& GetTables() {
+  static const Tables tables;
+  return tables;
+}
+
+uint64_t NumOffsetBits(const BitVector& bv, uint64_t numBlocks) {
+  const auto& tables = GetTables();
+  uint64_t numBits = 0;
+  for (uint64_t i = 0; i < numBlocks; ++i) {
+    const uint64_t from = i * BLOCK_SIZE;
+    numBits += tables.m_offsetBits[PopCount(bv.GetBits(from, std::min(BLOCK_SIZE, bv.NumBits() - from)))];
+  }
+  return numBits;
+}
+}  // namespace
+
+RRR::RRR(const BitVector& bv)
+    : m_numBits{bv.NumBits()}, m_offsets{NumOffsetBits(bv, bv.NumBits() / BLOCK_SIZE + 1)} {
+  const auto& tables = GetTables();
+
+  // There always is a block for a position right after the last bit,
+  // which may be empty.
+  const uint64_t numBlocks = m_numBits / BLOCK_SIZE + 1;
+  m_classes.resize((numBlocks + 15) / 16);
+  m_samples.resize((numBlocks + BLOCKS_PER_SAMPLE - 1) / BLOCKS_PER_SAMPLE);
+
+  uint64_t rank = 0;
+  uint64_t offset = 0;
+  for (uint64_t i = 0; i < numBlocks; ++i) {
+    if (i % BLOCKS_PER_SAMPLE == 0)
+      m_samples[i / BLOCKS_PER_SAMPLE] = {rank, offset};
+
+    const uint64_t from = i * BLOCK_SIZE;
+    const uint64_t bits = bv.GetBits(from, std::min(BLOCK_SIZE, m_numBits - from));
+    const uint8_t c = PopCount(bits);
+    m_classes[i / 16] |= static_cast<uint64_t>(c) << (4 * (i % 16));
+    m_offsets.SetBits(offset, tables.m_offsetBits[c], tables.Encode(bits));
+
+    rank += c;
+    offset += tables.m_offsetBits[c];
+  }
+  m_numOnes = rank;
+}
+
+bool RRR::Test(uint64_t bit) const {
+  assert(bit < m_numBits);
+  return (Decode(Find(bit / BLOCK_SIZE)) >> (bit % BLOCK_SIZE)) & 1;
+}
+
+uint64_t RRR::Rank1(uint64_t n) const {
+  assert(n <= m_numBits);
+  const auto cursor = Find(n / BLOCK_SIZE);
+  const uint64_t mask = (static_cast<uint64_t>(1) << (n % BLOCK_SIZE)) - 1;
+  return cursor.m_rank + PopCount(Decode(cursor) & mask);
+}
+
+uint64_t RRR::Select0(uint64_t k) const {
+  assert(k < NumZeros());
+  const auto rank0 = [](const Cursor& cursor) { return cursor.m_block * BLOCK_SIZE - cursor.m_rank; };
+
+  auto cursor = SampleCursor(LastSample([&](uint64_t sample) { return rank0(SampleCursor(sample)) <= k; }));
+  while (rank0(cursor) + BLOCK_SIZE - Class(cursor.m_block) <= k)
+    Advance(cursor);
+  return cursor.m_block * BLOCK_SIZE + SelectInWord(~Decode(cursor), k - rank0(cursor));
+}
+
+uint64_t RRR::Select1(uint64_t k) const {
+  assert(k < NumOnes());
+  auto cursor = SampleCursor(LastSample([&](uint64_t sample) { return m_samples[sample].m_rank <= k; }));
+  while (cursor.m_rank + Class(cursor.m_block) <= k)
+    Advance(cursor);
+  return cursor.m_block * BLOCK_SIZE + SelectInWord(Decode(cursor), k - cursor.m_rank);
+}
+
+uint64_t RRR::SizeInBytes() const {
+  return sizeof(*this) + 8 * (m_classes.size() + m_offsets.NumBlocks()) + sizeof(Sample) * m_samples.size();
+}
+
+uint64_t RRR::Decode(const Cursor& cursor) const {
+  const auto& tables = GetTables();
+  const uint8_t c = Class(cursor.m_block);
+  return tables.m_decode[tables.m_starts[c] + m_offsets.GetBits(cursor.m_offset, tables.m_offsetBits[c])];
+}
+
+void RRR::Advance(Cursor& cursor) const {
+  const uint8_t c = Class(cursor.m_block);
+  ++cursor.m_block;
+  cursor.m_rank += c;
+  cursor.m_offset += GetTables().m_offsetBits[c];
+}
+
+RRR::Cursor RRR::Find(uint64_t block) const {
+  auto cursor = SampleCursor(block / BLOCKS_PER_SAMPLE);
+  while (cursor.m_block != block)
+    Advance(cursor);
+  return cursor;
+}
+}  // namespace algo
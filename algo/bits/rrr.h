@@ -0,0 +1,106 @@
+#pragma once
+
+#include "bits/bit_vector.h"
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace algo {
+// RRR (Raman, Raman, Rao) encoding of a bit vector. Bits are split
+// into blocks of BLOCK_SIZE bits, each block is stored as its class
+// (number of ones) in 4 bits and its offset (index among all blocks
+// of the same class) in ceil(log(C(BLOCK_SIZE, class))) bits. Blocks
+// with few or many ones have short offsets, so the encoding
+// compresses both sparse and dense bit vectors.
+//
+// Every BLOCKS_PER_SAMPLE blocks a sample stores a rank and a
+// position in the offsets stream, so queries decode at most
+// BLOCKS_PER_SAMPLE classes and one offset.
+class RRR {
+public:
+  static constexpr uint64_t BLOCK_SIZE = 15;
+  static constexpr uint64_t BLOCKS_PER_SAMPLE = 32;
+
+  explicit RRR(const BitVector& bv);
+
+  bool Test(uint64_t bit) const;
+
+  // Returns number of zeroes among the first |n| bits.
+  uint64_t Rank0(uint64_t n) const { return n - Rank1(n); }
+
+  // Returns number of ones among the first |n| bits.
+  uint64_t Rank1(uint64_t n) const;
+
+  // Returns position of the |k|-th (0-based) zero. |k| should be
+  // less than NumZeros().
+  uint64_t Select0(uint64_t k) const;
+
+  // Returns position of the |k|-th (0-based) one. |k| should be less
+  // than NumOnes().
+  uint64_t Select1(uint64_t k) const;
+
+  uint64_t NumBits() const { return m_numBits; }
+  uint64_t NumZeros() const { return m_numBits - m_numOnes; }
+  uint64_t NumOnes() const { return m_numOnes; }
+
+  // Returns total size of the encoding.
+  uint64_t SizeInBytes() const;
+
+private:
+  struct Sample {
+    // Number of ones before the sample.
+    uint64_t m_rank{};
+    // Position of the first offset of the sample in |m_offsets|.
+    uint64_t m_offset{};
+  };
+
+  // Position of a block: number of ones before it and position of its
+  // offset in |m_offsets|.
+  struct Cursor {
+    uint64_t m_block{};
+    uint64_t m_rank{};
+    uint64_t m_offset{};
+  };
+
+  uint8_t Class(uint64_t block) const { return (m_classes[block / 16] >> (4 * (block % 16))) & 0xF; }
+
+  // Returns bits of a block pointed by |cursor|.
+  uint64_t Decode(const Cursor& cursor) const;
+
+  // Returns cursor at the start of |sample|.
+  Cursor SampleCursor(uint64_t sample) const {
+    return {sample * BLOCKS_PER_SAMPLE, m_samples[sample].m_rank, m_samples[sample].m_offset};
+  }
+
+  // Moves |cursor| to the next block.
+  void Advance(Cursor& cursor) const;
+
+  // Returns cursor at the start of |block|.
+  Cursor Find(uint64_t block) const;
+
+  // Returns the last sample satisfying |pred|, which should hold for
+  // the first sample and be monotone.
+  template <typename Pred>
+  uint64_t LastSample(Pred&& pred) const {
+    uint64_t lo = 0;
+    uint64_t hi = m_samples.size();
+    while (lo + 1 < hi) {
+      const uint64_t mi = lo + (hi - lo) / 2;
+      if (pred(mi))
+        lo = mi;
+      else
+        hi = mi;
+    }
+    return lo;
+  }
+
+  uint64_t m_numBits{};
+  uint64_t m_numOnes{};
+
+  // Classes of blocks, 16 per word.
+  std::vector<uint64_t> m_classes;
+  BitVector m_offsets;
+  std::vector<Sample> m_samples;
+};
+}  // namespace algo
@@ -6,20 +6,27 @@
 #include <cassert>
 
 namespace algo {
-RSTable::RSTable(const BitVector& bv) : m_bv{bv} {
-  const uint64_t numSuperBlocks = (bv.NumBlocks() + 7) / 8;
-  m_superBlocks.resize(numSuperBlocks);
+RSTable::RSTable(const BitVector& bv)
+    : m_blocks{&bv.Block(0), bv.NumBlocks()}, m_numBits{bv.NumBits()} {
+  // There always is a super block for a position right after the
+  // last block, and the tail of the last super block is filled as if
+  // it had zero blocks. This keeps relative ranks non-decreasing,
+  // which is needed by Select*().
+  const uint64_t numSuperBlocks = bv.NumBlocks() / 8 + 1;
+  auto& superBlocks = m_superBlocksStorage;
+  superBlocks.resize(numSuperBlocks);
 
   uint64_t rank = 0;
-  m_superBlocks[0].m_startRank = rank;
-  for (uint64_t i = 0; i < bv.NumBlocks(); ++i) {
+  superBlocks[0].m_startRank = rank;
+  for (uint64_t i = 0; i + 1 < 8 * numSuperBlocks; ++i) {
     const uint64_t p = i + 1;
     const uint64_t superBlock = p / 8;
     const uint64_t superBlockOffset = p % 8;
 
-    rank += PopCount(bv.Block(i));
+    if (i < bv.NumBlocks())
+      rank += PopCount(bv.Block(i));
 
-    auto& sp = m_superBlocks[superBlock];
+    auto& sp = superBlocks[superBlock];
     if (superBlockOffset == 0) {
       sp.m_startRank = rank;
     } else {
@@ -27,10 +34,31 @@ RSTable::RSTable(const BitVector& bv) : m_bv{bv} {
       sp.m_otherRanks |= (rank - sp.m_startRank) << offset;
     }
   }
+  m_numOnes = rank;
+
+  uint64_t nextOne = 0;
+  uint64_t nextZero = 0;
+  for (uint64_t i = 0; i < numSuperBlocks; ++i) {
+    const bool last = i + 1 == numSuperBlocks;
+
+    const uint64_t endRank1 = last ? NumOnes() : superBlocks[i + 1].m_startRank;
+    for (; nextOne < endRank1; nextOne += SELECT_SAMPLE_RATE)
+      m_selectSamples1Storage.push_back(i);
+
+    const uint64_t endRank0 = last ? NumZeros() : std::min(SuperBlockRank0(superBlocks[i + 1], i + 1), NumZeros());
+    for (; nextZero < endRank0; nextZero += SELECT_SAMPLE_RATE)
+      m_selectSamples0Storage.push_back(i);
+  }
+  m_selectSamples0Storage.push_back(numSuperBlocks - 1);
+  m_selectSamples1Storage.push_back(numSuperBlocks - 1);
+
+  m_superBlocks = superBlocks;
+  m_selectSamples0 = m_selectSamples0Storage;
+  m_selectSamples1 = m_selectSamples1Storage;
 }
 
 uint64_t RSTable::Rank1(uint64_t n) const {
-  assert(n <= m_bv.NumBits());
+  assert(n <= m_numBits);
   const uint64_t block = n / 64;
   const uint64_t blockOffset = n % 64;
 
@@ -53,8 +81,80 @@ uint64_t RSTable::Rank1(uint64_t n) const {
   rank += (sb.m_otherRanks >> offset) & 0x1FF;
 
   const uint64_t mask = (static_cast<uint64_t>(1) << blockOffset) - 1;
-  rank += PopCount(m_bv.Block(block) & mask);
+  rank += PopCount(m_blocks[block] & mask);
 
   return rank;
 }
+
+void RSTable::Rank1(std::span<const uint64_t> ns, std::span<uint64_t> ranks) const {
+  assert(ns.size() == ranks.size());
+
+  const auto prefetch = [this](uint64_t n) {
+    assert(n <= m_numBits);
+    __builtin_prefetch(&m_superBlocks[n / 512]);
+    __builtin_prefetch(&m_blocks[n / 64]);
+  };
+
+  const uint64_t size = ns.size();
+  for (uint64_t i = 0; i < std::min(size, RANK_PREFETCH_DISTANCE); ++i)
+    prefetch(ns[i]);
+
+  for (uint64_t i = 0; i < size; ++i) {
+    if (i + RANK_PREFETCH_DISTANCE < size)
+      prefetch(ns[i + RANK_PREFETCH_DISTANCE]);
+    ranks[i] = Rank1(ns[i]);
+  }
+}
+
+uint64_t RSTable::Select0(uint64_t k) const {
+  assert(k < NumZeros());
+
+  // Finds the last super block in [lo, hi] with less than or equal
+  // to |k| zeroes before it.
+  uint64_t lo = m_selectSamples0[k / SELECT_SAMPLE_RATE];
+  uint64_t hi = m_selectSamples0[k / SELECT_SAMPLE_RATE + 1] + 1;
+  while (lo + 1 < hi) {
+    const uint64_t mi = lo + (hi - lo) / 2;
+    if (SuperBlockRank0(m_superBlocks[mi], mi) <= k)
+      lo = mi;
+    else
+      hi = mi;
+  }
+
+  const auto& sb = m_superBlocks[lo];
+  const uint64_t rank = k - SuperBlockRank0(sb, lo);
+
+  uint64_t offset = 0;
+  for (uint64_t i = 1; i < 8; ++i)
+    offset += 64 * i - BlockRank(sb, i) <= rank;
+
+  const uint64_t block = 8 * lo + offset;
+  return 64 * block + SelectInWord(~m_blocks[block], rank - (64 * offset - BlockRank(sb, offset)));
+}
+
+uint64_t RSTable::Select1(uint64_t k) const {
+  assert(k < NumOnes());
+
+  // Finds the last super block in [lo, hi] with less than or equal
+  // to |k| ones before it.
+  uint64_t lo = m_selectSamples1[k / SELECT_SAMPLE_RATE];
+  uint64_t hi = m_selectSamples1[k / SELECT_SAMPLE_RATE + 1] + 1;
+  while (lo + 1 < hi) {
+    const uint64_t mi = lo + (hi - lo) / 2;
+    if (m_superBlocks[mi].m_startRank <= k)
+      lo = mi;
+    else
+      hi = mi;
+  }
+
+  const auto& sb = m_superBlocks[lo];
+  const uint64_t rank = k - sb.m_startRank;
+
+  uint64_t offset = 0;
+  for (uint64_t i = 1; i < 8; ++i)
+    offset += BlockRank(sb, i) <= rank;
+
+  const uint64_t block = 8 * lo + offset;
+  return 64 * block + SelectInWord(m_blocks[block], rank - BlockRank(sb, offset));
+}
 }  // namespace algo
@@ -2,30 +2,119 @@
 
 #include "bits/bit_vector.h"
 
+#include <cassert>
 #include <climits>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 namespace algo {
+class MappedRSTable;
+
 class RSTable {
 public:
   static_assert(CHAR_BIT == 8, "");
 
+  // Select queries are answered with the help of sampled positions:
+  // for every SELECT_SAMPLE_RATE-th one (zero) the table stores the
+  // super block it belongs to. With 512 bits per super block this
+  // costs at most 64 / SELECT_SAMPLE_RATE extra bits per bit for each
+  // kind of select.
+  static constexpr uint64_t SELECT_SAMPLE_RATE = 4096;
+
+  static constexpr uint64_t RANK_PREFETCH_DISTANCE = 16;
+
+  // Builds the table for |bv|. |bv| must outlive the table.
   explicit RSTable(const BitVector& bv);
 
+  RSTable(const RSTable&) = delete;
+  RSTable(RSTable&&) = default;
+
+  RSTable& operator=(const RSTable&) = delete;
+  RSTable& operator=(RSTable&&) = default;
+
+  bool Test(uint64_t bit) const {
+    assert(bit < m_numBits);
+    return (m_blocks[bit / 64] >> (bit % 64)) & 1;
+  }
+
   // Returns number of zeroes among the first |n| bits.
   uint64_t Rank0(uint64_t n) const { return n - Rank1(n); }
 
   // Returns number of ones among the first |n| bits.
   uint64_t Rank1(uint64_t n) const;
 
+  // Stores Rank1(ns[i]) to ranks[i] for all i. Both spans should have
+  // the same size.
+  //
+  // Super blocks and bit blocks of queries that are
+  // RANK_PREFETCH_DISTANCE positions ahead are prefetched, so memory
+  // latencies of independent queries overlap. This is much faster
+  // than a loop over Rank1() when the table doesn't fit in cache.
+  void Rank1(std::span<const uint64_t> ns, std::span<uint64_t> ranks) const;
+
+  // Returns position of the |k|-th (0-based) zero. |k| should be
+  // less than NumZeros().
+  uint64_t Select0(uint64_t k) const;
+
+  // Returns position of the |k|-th (0-based) one. |k| should be less
+  // than NumOnes().
+  uint64_t Select1(uint64_t k) const;
+
+  uint64_t NumBits() const { return m_numBits; }
+  uint64_t NumZeros() const { return m_numBits - m_numOnes; }
+  uint64_t NumOnes() const { return m_numOnes; }
+
+  // Returns size of the table, without bits it was built for.
+  uint64_t SizeInBytes() const {
+    return sizeof(*this) + m_superBlocks.size_bytes() + m_selectSamples0.size_bytes() +
+           m_selectSamples1.size_bytes();
+  }
+
 private:
+  friend class MappedRSTable;
+
   struct SuperBlock {
     uint64_t m_startRank{};
     uint64_t m_otherRanks{};
   };
 
-  const BitVector& m_bv;
-  std::vector<SuperBlock> m_superBlocks;
+  RSTable(uint64_t numBits, uint64_t numOnes, std::span<const uint64_t> blocks,
+          std::span<const SuperBlock> superBlocks, std::span<const uint64_t> selectSamples0,
+          std::span<const uint64_t> selectSamples1)
+      : m_blocks{blocks}
+      , m_superBlocks{superBlocks}
+      , m_selectSamples0{selectSamples0}
+      , m_selectSamples1{selectSamples1}
+      , m_numBits{numBits}
+      , m_numOnes{numOnes} {}
+
+  // Returns number of ones before |offset|-th block of |sb|, where
+  // 0 <= |offset| < 8.
+  static uint64_t BlockRank(const SuperBlock& sb, uint64_t offset) {
+    return offset == 0 ? 0 : (sb.m_otherRanks >> (9 * (offset - 1))) & 0x1FF;
+  }
+
+  // Returns number of zeroes before |superBlock|.
+  static uint64_t SuperBlockRank0(const SuperBlock& sb, uint64_t superBlock) {
+    return superBlock * 512 - sb.m_startRank;
+  }
+
+  // Queries run over these spans. They point either to the bit
+  // vector and to the storage below, or to a memory-mapped file.
+  std::span<const uint64_t> m_blocks;
+  std::span<const SuperBlock> m_superBlocks;
+
+  // Super blocks for every SELECT_SAMPLE_RATE-th zero/one, followed
+  // by the index of the last super block as a sentinel.
+  std::span<const uint64_t> m_selectSamples0;
+  std::span<const uint64_t> m_selectSamples1;
+
+  uint64_t m_numBits{};
+  uint64_t m_numOnes{};
+
+  std::vector<SuperBlock> m_superBlocksStorage;
+  std::vector<uint64_t> m_selectSamples0Storage;
+  std::vector<uint64_t> m_selectSamples1Storage;
 };
 }  // namespace algo
@@ -4,6 +4,9 @@
 #include "bits/rs_table.h"
 #include "math/math.h"
 
+#include <random>
+#include <vector>
+
 using namespace algo;
 
 namespace {
@@ -49,4 +52,77 @@ TEST(Bits, RSTable_Smoke) {
     ASSERT_EQ(rank, rs.Rank1(bv.NumBits()));
   }
 }
+
+TEST(Bits, RSTable_Select) {
+  std::mt19937_64 engine(42);
+
+  for (const auto size : {1, 63, 64, 65, 448, 511, 512, 513, 5000, 100000}) {
+    for (const double density : {0.0, 0.001, 0.05, 0.5, 0.95, 1.0}) {
+      std::bernoulli_distribution bit(density);
+
+      BitVector bv(size);
+      std::vector<uint64_t> zeros;
+      std::vector<uint64_t> ones;
+      for (uint64_t i = 0; i < bv.NumBits(); ++i) {
+        if (bit(engine)) {
+          bv.Set(i);
+          ones.push_back(i);
+        } else {
+          zeros.push_back(i);
+        }
+      }
+
+      RSTable rs(bv);
+      ASSERT_EQ(zeros.size(), rs.NumZeros());
+      ASSERT_EQ(ones.size(), rs.NumOnes());
+      for (uint64_t k = 0; k < zeros.size(); ++k)
+        ASSERT_EQ(zeros[k], rs.Select0(k)) << size << " " << density << " " << k;
+      for (uint64_t k = 0; k < ones.size(); ++k)
+        ASSERT_EQ(ones[k], rs.Select1(k)) << size << " " << density << " " << k;
+    }
+  }
+}
+
+TEST(Bits, RSTable_SelectSparse) {
+  BitVector bv(1 << 20);
+  const std::vector<uint64_t> ones = {0, 1, 4095, 4096, 70000, 70001, 500000, (1 << 20) - 1};
+  for (const auto i : ones)
+    bv.Set(i);
+
+  RSTable rs(bv);
+  ASSERT_EQ(ones.size(), rs.NumOnes());
+  for (uint64_t k = 0; k < ones.size(); ++k) {
+    ASSERT_EQ(ones[k], rs.Select1(k));
+    ASSERT_EQ(k, rs.Rank1(rs.Select1(k)));
+  }
+  for (uint64_t k = 0; k < rs.NumZeros(); k += 997) {
+    const auto pos = rs.Select0(k);
+    ASSERT_FALSE(bv.Test(pos));
+    ASSERT_EQ(k, rs.Rank0(pos));
+  }
+}
+
+TEST(Bits, RSTable_BatchRank) {
+  std::mt19937_64 engine(42);
+
+  BitVector bv(100000);
+  for (uint64_t i = 0; i < bv.NumBits(); ++i) {
+    if (engine() % 3 == 0)
+      bv.Set(i);
+  }
+  RSTable rs(bv);
+
+  for (const size_t size : {0, 1, 15, 16, 17, 1000}) {
+    std::vector<uint64_t> ns(size);
+    for (auto& n : ns)
+      n = engine() % (bv.NumBits() + 1);
+    if (!ns.empty())
+      ns.back() = bv.NumBits();
+
+    std::vector<uint64_t> ranks(size);
+    rs.Rank1(ns, ranks);
+    for (size_t i = 0; i < size; ++i)
+      ASSERT_EQ(rs.Rank1(ns[i]), ranks[i]);
+  }
+}
 }  // namespace
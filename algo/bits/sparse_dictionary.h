@@ -0,0 +1,310 @@
+#pragma once
+
+#include "bits/bits.h"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace algo {
+// Same as Dictionary, but for universes up to 2^64. This is a 64-ary
+// trie where each inner node is a 64-bit mask of non-empty children,
+// and children are stored contiguously, ordered by digit, so a child
+// is found by a popcount over the mask. Nodes are allocated only when
+// non-empty, thus memory is proportional to the number of keys rather
+// than to the size of the universe.
+template <uint64_t LogSize>
+class SparseDictionary {
+public:
+  static_assert(LogSize > 6 && LogSize <= 64);
+
+  static constexpr uint64_t NUM_LEVELS = (LogSize + 5) / 6;
+
+  SparseDictionary() { m_nodes.Allocate(1); }
+
+  // Sets |i|-th bit.
+  // Complexity: O(LogSize) amortized.
+  void Set(uint64_t i) {
+    CheckKey(i);
+    uint32_t node = 0;
+    for (uint64_t level = 0; level + 2 < NUM_LEVELS; ++level) {
+      const auto digit = Digit(i, level);
+      node = Has(m_nodes[node].m_mask, digit) ? ChildIndex(m_nodes[node], digit) : InsertChild(m_nodes, node, digit);
+    }
+
+    const auto digit = Digit(i, NUM_LEVELS - 2);
+    const auto leaf =
+        Has(m_nodes[node].m_mask, digit) ? ChildIndex(m_nodes[node], digit) : InsertChild(m_leaves, node, digit);
+    m_leaves[leaf] |= static_cast<uint64_t>(1) << Digit(i, NUM_LEVELS - 1);
+  }
+
+  // Clears |i|-th bit. Nodes that become empty are returned to the
+  // arena.
+  // Complexity: O(LogSize) amortized.
+  void Clear(uint64_t i) {
+    CheckKey(i);
+    std::array<uint32_t, NUM_LEVELS - 1> path;
+    uint32_t node = 0;
+    for (uint64_t level = 0; level + 1 < NUM_LEVELS; ++level) {
+      path[level] = node;
+      const auto digit = Digit(i, level);
+      if (!Has(m_nodes[node].m_mask, digit))
+        return;
+      node = ChildIndex(m_nodes[node], digit);
+    }
+
+    auto& leaf = m_leaves[node];
+    leaf &= ~(static_cast<uint64_t>(1) << Digit(i, NUM_LEVELS - 1));
+    if (leaf != 0)
+      return;
+
+    RemoveChild(m_leaves, path[NUM_LEVELS - 2], Digit(i, NUM_LEVELS - 2));
+    for (uint64_t level = NUM_LEVELS - 2; level-- > 0;) {
+      if (m_nodes[path[level + 1]].m_mask != 0)
+        return;
+      RemoveChild(m_nodes, path[level], Digit(i, level));
+    }
+  }
+
+  // Gets state of the |i|-th bit.
+  // Complexity: O(LogSize).
+  bool Get(uint64_t i) const {
+    CheckKey(i);
+    uint32_t node = 0;
+    for (uint64_t level = 0; level + 1 < NUM_LEVELS; ++level) {
+      const auto digit = Digit(i, level);
+      if (!Has(m_nodes[node].m_mask, digit))
+        return false;
+      node = ChildIndex(m_nodes[node], digit);
+    }
+    return Has(m_leaves[node], Digit(i, NUM_LEVELS - 1));
+  }
+
+  // Returns true iff the dictionary is empty.
+  // Complexity: O(1).
+  bool Empty() const { return m_nodes[0].m_mask == 0; }
+
+  // Returns min value from the dictionary.
+  // Complexity: O(LogSize).
+  std::optional<uint64_t> Min() const {
+    if (Empty())
+      return {};
+    return DescendMin(0 /* node */, 0 /* level */, 0 /* prefix */);
+  }
+
+  // Returns max value from the dictionary.
+  // Complexity: O(LogSize).
+  std::optional<uint64_t> Max() const {
+    if (Empty())
+      return {};
+    return DescendMax(0 /* node */, 0 /* level */, 0 /* prefix */);
+  }
+
+  // Returns rightmost set bit with position less than |i|.
+  // Complexity: O(LogSize).
+  std::optional<uint64_t> Pred(uint64_t i) const {
+    CheckKey(i);
+    std::array<uint32_t, NUM_LEVELS - 1> path;
+    uint64_t depth = 0;
+    for (uint32_t node = 0; depth + 1 < NUM_LEVELS;) {
+      path[depth] = node;
+      const auto digit = Digit(i, depth);
+      ++depth;
+      if (!Has(m_nodes[node].m_mask, digit))
+        break;
+      node = ChildIndex(m_nodes[node], digit);
+      if (depth + 1 == NUM_LEVELS) {
+        if (const auto bits = m_leaves[node] & LowMask(Digit(i, depth)))
+          return (Prefix(i, depth) << 6) | HiPosUnsafe(bits);
+      }
+    }
+
+    while (depth-- > 0) {
+      const auto& node = m_nodes[path[depth]];
+      if (const auto bits = node.m_mask & LowMask(Digit(i, depth))) {
+        const auto digit = HiPosUnsafe(bits);
+        return DescendMax(ChildIndex(node, digit), depth + 1, (Prefix(i, depth) << 6) | digit);
+      }
+    }
+    return {};
+  }
+
+  // Returns leftmost set bit with position greater than |i|.
+  // Complexity: O(LogSize).
+  std::optional<uint64_t> Succ(uint64_t i) const {
+    CheckKey(i);
+    std::array<uint32_t, NUM_LEVELS - 1> path;
+    uint64_t depth = 0;
+    for (uint32_t node = 0; depth + 1 < NUM_LEVELS;) {
+      path[depth] = node;
+      const auto digit = Digit(i, depth);
+      ++depth;
+      if (!Has(m_nodes[node].m_mask, digit))
+        break;
+      node = ChildIndex(m_nodes[node], digit);
+      if (depth + 1 == NUM_LEVELS) {
+        if (const auto bits = m_leaves[node] & HighMask(Digit(i, depth)))
+          return (Prefix(i, depth) << 6) | LoPosUnsafe(bits);
+      }
+    }
+
+    while (depth-- > 0) {
+      const auto& node = m_nodes[path[depth]];
+      if (const auto bits = node.m_mask & HighMask(Digit(i, depth))) {
+        const auto digit = LoPosUnsafe(bits);
+        return DescendMin(ChildIndex(node, digit), depth + 1, (Prefix(i, depth) << 6) | digit);
+      }
+    }
+    return {};
+  }
+
+  // Returns number of bytes occupied by nodes, including free ones.
+  size_t SizeInBytes() const { return m_nodes.SizeInBytes() + m_leaves.SizeInBytes(); }
+
+private:
+  struct Node {
+    // |d|-th bit is set iff |d|-th child is non-empty.
+    uint64_t m_mask{};
+
+    // Index of the first child in the arena of the next level.
+    uint32_t m_children{};
+  };
+
+  // Storage for contiguous blocks of at most 64 elements. Freed
+  // blocks are kept in per-size free lists and reused.
+  template <typename T>
+  class Arena {
+  public:
+    uint32_t Allocate(uint32_t size) {
+      assert(size != 0 && size <= 64);
+      auto& free = m_free[size];
+      if (!free.empty()) {
+        const auto index = free.back();
+        free.pop_back();
+        return index;
+      }
+      assert(m_items.size() + size <= UINT32_MAX);
+      const auto index = static_cast<uint32_t>(m_items.size());
+      m_items.resize(m_items.size() + size);
+      return index;
+    }
+
+    void Free(uint32_t index, uint32_t size) {
+      assert(size != 0 && size <= 64);
+      m_free[size].push_back(index);
+    }
+
+    T& operator[](uint32_t i) { return m_items[i]; }
+    const T& operator[](uint32_t i) const { return m_items[i]; }
+
+    size_t SizeInBytes() const {
+      size_t size = m_items.capacity() * sizeof(T);
+      for (const auto& free : m_free)
+        size += free.capacity() * sizeof(uint32_t);
+      return size;
+    }
+
+  private:
+    std::vector<T> m_items;
+    std::array<std::vector<uint32_t>, 65> m_free;
+  };
+
+  static void CheckKey([[maybe_unused]] uint64_t i) {
+    if constexpr (LogSize < 64)
+      assert(i < (static_cast<uint64_t>(1) << LogSize));
+  }
+
+  // Returns 6-bit digit of |i| on the |level|, where level 0 is the
+  // root.
+  static uint64_t Digit(uint64_t i, uint64_t level) { return (i >> (6 * (NUM_LEVELS - 1 - level))) & 63; }
+
+  // Returns digits of |i| above the |level|.
+  static uint64_t Prefix(uint64_t i, uint64_t level) {
+    return level == 0 ? 0 : i >> (6 * (NUM_LEVELS - level));
+  }
+
+  static bool Has(uint64_t mask, uint64_t digit) { return (mask >> digit) & 1; }
+
+  // Returns mask of bits less than |digit|.
+  static uint64_t LowMask(uint64_t digit) { return (static_cast<uint64_t>(1) << digit) - 1; }
+
+  // Returns mask of bits greater than |digit|.
+  static uint64_t HighMask(uint64_t digit) { return ~((static_cast<uint64_t>(2) << digit) - 1); }
+
+  static uint32_t ChildIndex(const Node& node, uint64_t digit) {
+    return node.m_children + PopCount(node.m_mask & LowMask(digit));
+  }
+
+  // Adds an empty |digit|-th child to the |node| and returns its
+  // index in |arena|. Takes an index instead of a reference, because
+  // |arena| may be the one holding the |node|.
+  template <typename T>
+  uint32_t InsertChild(Arena<T>& arena, uint32_t node, uint64_t digit) {
+    const auto [mask, children] = m_nodes[node];
+    const auto size = static_cast<uint32_t>(PopCount(mask));
+    const auto pos = static_cast<uint32_t>(PopCount(mask & LowMask(digit)));
+
+    const auto block = arena.Allocate(size + 1);
+    for (uint32_t j = 0; j < pos; ++j)
+      arena[block + j] = arena[children + j];
+    arena[block + pos] = T{};
+    for (uint32_t j = pos; j < size; ++j)
+      arena[block + j + 1] = arena[children + j];
+    if (size != 0)
+      arena.Free(children, size);
+
+    m_nodes[node] = Node{mask | (static_cast<uint64_t>(1) << digit), block};
+    return block + pos;
+  }
+
+  // Removes an empty |digit|-th child of the |node|.
+  template <typename T>
+  void RemoveChild(Arena<T>& arena, uint32_t node, uint64_t digit) {
+    const auto [mask, children] = m_nodes[node];
+    const auto size = static_cast<uint32_t>(PopCount(mask));
+    const auto pos = static_cast<uint32_t>(PopCount(mask & LowMask(digit)));
+
+    uint32_t block = 0;
+    if (size != 1) {
+      block = arena.Allocate(size - 1);
+      for (uint32_t j = 0; j < pos; ++j)
+        arena[block + j] = arena[children + j];
+      for (uint32_t j = pos + 1; j < size; ++j)
+        arena[block + j - 1] = arena[children + j];
+    }
+    arena.Free(children, size);
+
+    m_nodes[node] = Node{mask & ~(static_cast<uint64_t>(1) << digit), block};
+  }
+
+  // Returns min value in the subtree of the non-empty |node| on the
+  // |level|, where |prefix| holds digits of the path to the |node|.
+  uint64_t DescendMin(uint32_t node, uint64_t level, uint64_t prefix) const {
+    for (; level + 1 < NUM_LEVELS; ++level) {
+      prefix = (prefix << 6) | LoPosUnsafe(m_nodes[node].m_mask);
+      node = m_nodes[node].m_children;
+    }
+    return (prefix << 6) | LoPosUnsafe(m_leaves[node]);
+  }
+
+  // Returns max value in the subtree of the non-empty |node| on the
+  // |level|, where |prefix| holds digits of the path to the |node|.
+  uint64_t DescendMax(uint32_t node, uint64_t level, uint64_t prefix) const {
+    for (; level + 1 < NUM_LEVELS; ++level) {
+      const auto mask = m_nodes[node].m_mask;
+      prefix = (prefix << 6) | HiPosUnsafe(mask);
+      node = m_nodes[node].m_children + PopCount(mask) - 1;
+    }
+    return (prefix << 6) | HiPosUnsafe(m_leaves[node]);
+  }
+
+  // Inner nodes, the root is the first one.
+  Arena<Node> m_nodes;
+
+  // Masks of the last level.
+  Arena<uint64_t> m_leaves;
+};
+}  // namespace algo
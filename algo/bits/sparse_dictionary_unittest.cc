@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include "bits/dictionary.h"
+#include "bits/sparse_dictionary.h"
+
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <set>
+
+namespace algo {
+namespace {
+template <typename Dict>
+void CheckQuery(const Dict& dict, const std::set<uint64_t>& keys, uint64_t i) {
+  ASSERT_EQ(keys.count(i) != 0, dict.Get(i)) << i;
+
+  std::optional<uint64_t> succ;
+  if (const auto it = keys.upper_bound(i); it != keys.end())
+    succ = *it;
+  ASSERT_EQ(succ, dict.Succ(i)) << i;
+
+  std::optional<uint64_t> pred;
+  if (const auto it = keys.lower_bound(i); it != keys.begin())
+    pred = *std::prev(it);
+  ASSERT_EQ(pred, dict.Pred(i)) << i;
+}
+
+template <uint64_t LogSize>
+void TestRandom(uint64_t numKeys, uint64_t mask) {
+  std::mt19937_64 engine(LogSize /* seed */);
+  SparseDictionary<LogSize> dict;
+  std::set<uint64_t> keys;
+
+  for (uint64_t i = 0; i < numKeys; ++i) {
+    const auto key = engine() & mask;
+    if (engine() % 4 == 0) {
+      dict.Clear(key);
+      keys.erase(key);
+    } else {
+      dict.Set(key);
+      keys.insert(key);
+    }
+
+    ASSERT_EQ(keys.empty(), dict.Empty());
+    if (!keys.empty()) {
+      ASSERT_EQ(*keys.begin(), dict.Min());
+      ASSERT_EQ(*keys.rbegin(), dict.Max());
+    }
+    CheckQuery(dict, keys, key);
+    CheckQuery(dict, keys, engine() & mask);
+  }
+
+  for (const auto key : std::set<uint64_t>(keys))
+    dict.Clear(key);
+  ASSERT_TRUE(dict.Empty());
+  ASSERT_FALSE(dict.Min().has_value());
+  ASSERT_FALSE(dict.Succ(0).has_value());
+}
+}  // namespace
+
+TEST(Bits, SparseDictionary) {
+  SparseDictionary<20> dict;
+  dict.Set(1);
+  dict.Set(3);
+  dict.Set(5);
+
+  ASSERT_EQ(dict.Succ(2), 3);
+  ASSERT_EQ(dict.Pred(4), 3);
+  ASSERT_FALSE(dict.Pred(1).has_value());
+
+  dict.Set(4);
+  dict.Clear(3);
+
+  ASSERT_TRUE(dict.Get(4));
+  ASSERT_FALSE(dict.Get(3));
+
+  ASSERT_EQ(dict.Succ(2), 4);
+  ASSERT_EQ(dict.Pred(4), 1);
+}
+
+TEST(Bits, SparseDictionaryFullUniverse) {
+  SparseDictionary<64> dict;
+  ASSERT_TRUE(dict.Empty());
+
+  dict.Set(0);
+  dict.Set(UINT64_MAX);
+  ASSERT_EQ(dict.Min(), 0);
+  ASSERT_EQ(dict.Max(), UINT64_MAX);
+  ASSERT_EQ(dict.Succ(0), UINT64_MAX);
+  ASSERT_EQ(dict.Pred(UINT64_MAX), 0);
+  ASSERT_FALSE(dict.Succ(UINT64_MAX).has_value());
+  ASSERT_FALSE(dict.Pred(0).has_value());
+
+  dict.Clear(0);
+  ASSERT_EQ(dict.Min(), UINT64_MAX);
+  dict.Clear(UINT64_MAX);
+  ASSERT_TRUE(dict.Empty());
+}
+
+TEST(Bits, SparseDictionaryMatchesDictionary) {
+  std::mt19937_64 engine(0 /* seed */);
+  Dictionary<16> dense;
+  SparseDictionary<16> sparse;
+  for (int i = 0; i < 10000; ++i) {
+    const auto key = engine() % (1 << 16);
+    if (engine() % 3 == 0) {
+      dense.Clear(key);
+      sparse.Clear(key);
+    } else {
+      dense.Set(key);
+      sparse.Set(key);
+    }
+
+    const auto query = engine() % (1 << 16);
+    ASSERT_EQ(dense.Get(query), sparse.Get(query));
+    ASSERT_EQ(dense.Succ(query), sparse.Succ(query));
+    ASSERT_EQ(dense.Pred(query), sparse.Pred(query));
+  }
+}
+
+TEST(Bits, SparseDictionaryRandom) {
+  TestRandom<12>(10000, (1 << 12) - 1);
+  TestRandom<32>(10000, UINT32_MAX);
+  // Keys are clustered, so that paths share nodes on all levels.
+  TestRandom<40>(10000, 0xFF000003FF);
+  TestRandom<64>(10000, UINT64_MAX);
+  TestRandom<64>(10000, 0xF00000000000FFFF);
+}
+}  // namespace algo
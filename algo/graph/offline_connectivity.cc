@@ -0,0 +1,85 @@
+#include "graph/offline_connectivity.h"
+
+#include "sequences/rollback_dsu.h"
+#include "sequences/segtree.h"
+
+#include <cassert>
+
+namespace algo {
+namespace {
+using Edges = std::vector<std::pair<uint32_t, uint32_t>>;
+
+class Solver {
+public:
+  Solver(uint32_t n, const Edges& queries, std::vector<Edges>&& nodes, size_t base)
+      : m_dsu{n}, m_queries{queries}, m_nodes{std::move(nodes)}, m_base{base}, m_answers(queries.size()) {}
+
+  std::vector<OfflineConnectivity::Answer> Solve() && {
+    Visit(1 /* node */, 0 /* first */, m_base /* size */);
+    return std::move(m_answers);
+  }
+
+private:
+  // Visits |node| covering queries [|first|, |first| + |size|).
+  void Visit(size_t node, size_t first, size_t size) {
+    if (first >= m_queries.size())
+      return;
+
+    const auto snapshot = m_dsu.Snapshot();
+    for (const auto& [u, v] : m_nodes[node])
+      m_dsu.Union(u, v);
+
+    if (size == 1) {
+      const auto& [u, v] = m_queries[first];
+      m_answers[first] = {m_dsu.GetParent(u) == m_dsu.GetParent(v), m_dsu.NumComponents()};
+    } else {
+      Visit(FastSegTree<int>::Left(node), first, size / 2);
+      Visit(FastSegTree<int>::Right(node), first + size / 2, size / 2);
+    }
+
+    m_dsu.Rollback(snapshot);
+  }
+
+  RollbackDSU m_dsu;
+  const Edges& m_queries;
+  std::vector<Edges> m_nodes;
+  size_t m_base{};
+  std::vector<OfflineConnectivity::Answer> m_answers;
+};
+}  // namespace
+
+void OfflineConnectivity::AddEdge(uint32_t u, uint32_t v) {
+  assert(u < m_n && v < m_n);
+  m_open[Key(u, v)].push_back(m_intervals.size());
+  m_intervals.push_back(Interval{u, v, m_queries.size(), OPEN});
+}
+
+void OfflineConnectivity::RemoveEdge(uint32_t u, uint32_t v) {
+  const auto it = m_open.find(Key(u, v));
+  assert(it != m_open.end());
+  m_intervals[it->second.back()].m_to = m_queries.size();
+  it->second.pop_back();
+  if (it->second.empty())
+    m_open.erase(it);
+}
+
+std::vector<OfflineConnectivity::Answer> OfflineConnectivity::Solve() const {
+  if (m_queries.empty())
+    return {};
+
+  const size_t base = Ceil2Pow(m_queries.size());
+  std::vector<Edges> nodes(2 * base);
+  for (const auto& interval : m_intervals) {
+    size_t from = base + interval.m_from;
+    size_t to = base + (interval.m_to == OPEN ? m_queries.size() : interval.m_to);
+    for (; from < to; from = FastSegTree<int>::Parent(from), to = FastSegTree<int>::Parent(to)) {
+      if (from & 1)
+        nodes[from++].emplace_back(interval.m_u, interval.m_v);
+      if (to & 1)
+        nodes[--to].emplace_back(interval.m_u, interval.m_v);
+    }
+  }
+
+  return Solver{m_n, m_queries, std::move(nodes), base}.Solve();
+}
+}  // namespace algo
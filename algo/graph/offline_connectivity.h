@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace algo {
+// Offline dynamic connectivity: edges are added and removed, and
+// queries ask whether two vertices are connected at the moment. All
+// operations are recorded first and answered at once by Solve().
+//
+// Each edge is alive during an interval of queries. Intervals are
+// split on O(log q) nodes of a segment tree over queries, the same
+// way FastSegTree splits ranges. A DFS over the tree unites edges of
+// a node on entering it and rolls them back on leaving, so a query in
+// a leaf sees exactly the edges alive at its moment.
+// Complexity: O((q + m log q) log n), where m is the number of added
+// edges.
+class OfflineConnectivity {
+public:
+  struct Answer {
+    bool m_connected{};
+    uint32_t m_numComponents{};
+  };
+
+  explicit OfflineConnectivity(uint32_t n) : m_n{n} {}
+
+  // Adds edge (|u|, |v|). Parallel edges are allowed.
+  void AddEdge(uint32_t u, uint32_t v);
+
+  // Removes one copy of edge (|u|, |v|), which should be present.
+  void RemoveEdge(uint32_t u, uint32_t v);
+
+  // Asks whether |u| and |v| are connected by currently present
+  // edges.
+  void AddQuery(uint32_t u, uint32_t v) { m_queries.emplace_back(u, v); }
+
+  // Returns answers to all queries, in order of AddQuery() calls.
+  std::vector<Answer> Solve() const;
+
+private:
+  struct Interval {
+    uint32_t m_u{};
+    uint32_t m_v{};
+
+    // Edge is present for queries in [m_from, m_to).
+    size_t m_from{};
+    size_t m_to{};
+  };
+
+  static constexpr size_t OPEN = SIZE_MAX;
+
+  static std::pair<uint32_t, uint32_t> Key(uint32_t u, uint32_t v) { return u < v ? std::pair{u, v} : std::pair{v, u}; }
+
+  uint32_t m_n{};
+  std::vector<std::pair<uint32_t, uint32_t>> m_queries;
+  std::vector<Interval> m_intervals;
+
+  // Indices of open intervals for each present edge.
+  std::map<std::pair<uint32_t, uint32_t>, std::vector<size_t>> m_open;
+};
+}  // namespace algo
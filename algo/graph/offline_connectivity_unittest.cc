@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include "graph/offline_connectivity.h"
+#include "sequences/compact_dsu.h"
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace algo;
+
+namespace {
+TEST(OfflineConnectivity, Smoke) {
+  OfflineConnectivity connectivity{4};
+  connectivity.AddQuery(0, 1);
+  connectivity.AddEdge(0, 1);
+  connectivity.AddEdge(1, 2);
+  connectivity.AddQuery(0, 2);
+  connectivity.AddEdge(0, 1);
+  connectivity.RemoveEdge(1, 0);
+  connectivity.AddQuery(0, 2);
+  connectivity.RemoveEdge(0, 1);
+  connectivity.AddQuery(0, 2);
+  connectivity.AddQuery(3, 3);
+
+  const auto answers = connectivity.Solve();
+  ASSERT_EQ(5u, answers.size());
+  ASSERT_FALSE(answers[0].m_connected);
+  ASSERT_EQ(4u, answers[0].m_numComponents);
+  ASSERT_TRUE(answers[1].m_connected);
+  ASSERT_EQ(2u, answers[1].m_numComponents);
+  ASSERT_TRUE(answers[2].m_connected);
+  ASSERT_FALSE(answers[3].m_connected);
+  ASSERT_EQ(3u, answers[3].m_numComponents);
+  ASSERT_TRUE(answers[4].m_connected);
+}
+
+TEST(OfflineConnectivity, Random) {
+  const uint32_t n = 30;
+  std::mt19937 engine(0 /* seed */);
+  OfflineConnectivity connectivity{n};
+
+  std::vector<std::pair<uint32_t, uint32_t>> edges;
+  std::vector<OfflineConnectivity::Answer> expected;
+  for (int i = 0; i < 2000; ++i) {
+    const auto op = engine() % 3;
+    if (op == 0 || edges.empty()) {
+      const uint32_t u = engine() % n;
+      const uint32_t v = engine() % n;
+      connectivity.AddEdge(u, v);
+      edges.emplace_back(u, v);
+    } else if (op == 1) {
+      const auto j = engine() % edges.size();
+      std::swap(edges[j], edges.back());
+      connectivity.RemoveEdge(edges.back().first, edges.back().second);
+      edges.pop_back();
+    } else {
+      const uint32_t u = engine() % n;
+      const uint32_t v = engine() % n;
+      connectivity.AddQuery(u, v);
+
+      CompactDSU dsu{n};
+      for (const auto& [a, b] : edges)
+        dsu.Union(a, b);
+      expected.push_back({dsu.GetParent(u) == dsu.GetParent(v), dsu.NumComponents()});
+    }
+  }
+
+  const auto answers = connectivity.Solve();
+  ASSERT_EQ(expected.size(), answers.size());
+  for (size_t i = 0; i < answers.size(); ++i) {
+    ASSERT_EQ(expected[i].m_connected, answers[i].m_connected) << i;
+    ASSERT_EQ(expected[i].m_numComponents, answers[i].m_numComponents) << i;
+  }
+}
+}  // namespace
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace algo {
+// Same interface as Fenwick, but for arrays that do not fit into
+// caches. This is a B-ary tree where each node is a cache line of B
+// prefix sums over its children, so Add() and Sum() touch log_B(n)
+// cache lines instead of log_2(n) scattered ones for Fenwick.
+//
+// Entry c of a node is the sum of its children [0, c), thus Sum() is a
+// single load per level, and Add() updates a suffix of entries of one
+// node per level, which is branch-free and vectorized by compilers.
+// Upper levels are stored first, so the hot top of the tree is
+// contiguous.
+template <typename T, size_t B = 64 / sizeof(T)>
+class BlockedFenwick {
+public:
+  static_assert(B >= 2 && std::has_single_bit(B));
+
+  static constexpr size_t LOG_B = std::countr_zero(B);
+
+  explicit BlockedFenwick(size_t size) : m_size{size} { Allocate(); }
+
+  // Builds tree over |values| level by level.
+  // Complexity: O(n).
+  explicit BlockedFenwick(std::span<const T> values) : m_size{values.size()} {
+    Allocate();
+
+    std::vector<T> totals(values.begin(), values.end());
+    for (size_t level = 0; level < m_offsets.size(); ++level) {
+      const auto numNodes = NumNodes(level);
+      for (size_t node = 0; node < numNodes; ++node) {
+        auto& sums = m_nodes[m_offsets[level] + node].m_sums;
+        T sum{};
+        for (size_t c = 0; c < B; ++c) {
+          sums[c] = sum;
+          const auto child = node * B + c;
+          if (child < totals.size())
+            sum += totals[child];
+        }
+        totals[node] = sum;
+      }
+      totals.resize(numNodes);
+    }
+  }
+
+  // Adds |value| to an element on a position |index|.
+  // Complexity: O(B * log_B(n)).
+  void Add(size_t index, const T& value) {
+    assert(index < m_size);
+    for (size_t level = 0; level < m_offsets.size(); ++level, index >>= LOG_B) {
+      auto& node = m_nodes[m_offsets[level] + (index >> LOG_B)];
+      const auto& mask = SUFFIX_MASKS[index & (B - 1)].m_sums;
+      // Updates a local copy, so that the compiler does not have to
+      // care about aliasing of |value| and the node, and keeps the loop
+      // vectorized.
+      auto sums = node.m_sums;
+      for (size_t c = 0; c < B; ++c) {
+        if constexpr (std::is_integral_v<T>)
+          sums[c] += value & mask[c];
+        else
+          sums[c] += value * mask[c];
+      }
+      node.m_sums = sums;
+    }
+  }
+
+  // Returns sum on a range [0, |to|).
+  // Complexity: O(log_B(n)).
+  T Sum(size_t to) const {
+    assert(to <= m_size);
+    T result{};
+    for (size_t level = 0; level < m_offsets.size(); ++level, to >>= LOG_B)
+      result += m_nodes[m_offsets[level] + (to >> LOG_B)].m_sums[to & (B - 1)];
+    return result;
+  }
+
+  // Returns sum on a range [|from|, |to|).
+  T Sum(size_t from, size_t to) const {
+    assert(from <= to);
+    if (from == to)
+      return T{};
+    return Sum(to) - Sum(from);
+  }
+
+  // Same as Fenwick::LowerBound(). Each level counts entries less than
+  // |target| in a single node, instead of a branch per bit.
+  // Complexity: O(B * log_B(n)).
+  size_t LowerBound(T target) const {
+    // Otherwise the descent would pick the last entry of a node, which
+    // may be past the real children of the node.
+    if (Sum(m_size) < target)
+      return m_size;
+
+    size_t pos = 0;
+    for (size_t level = m_offsets.size(); level-- > 0;) {
+      const auto& sums = m_nodes[m_offsets[level] + pos].m_sums;
+      // Entries are non-decreasing and the first one is zero, so this
+      // is the last child starting before |target|.
+      size_t c = 0;
+      for (size_t i = 1; i < B; ++i)
+        c += sums[i] < target;
+      target -= sums[c];
+      pos = pos * B + c;
+    }
+    return pos;
+  }
+
+  size_t Size() const { return m_size; }
+
+private:
+  struct alignas(64) Node {
+    std::array<T, B> m_sums{};
+  };
+
+  // |d|-th mask selects entries after |d|: these are all ones for
+  // integers and ones for other types. Masks are cheaper than
+  // comparisons of indices, which are wider than T.
+  static constexpr auto SUFFIX_MASKS = [] {
+    std::array<Node, B> masks;
+    for (size_t d = 0; d < B; ++d) {
+      for (size_t c = d + 1; c < B; ++c) {
+        if constexpr (std::is_integral_v<T>)
+          masks[d].m_sums[c] = static_cast<T>(~static_cast<T>(0));
+        else
+          masks[d].m_sums[c] = static_cast<T>(1);
+      }
+    }
+    return masks;
+  }();
+
+  // Allocates levels for positions [0, m_size], so that Sum(m_size)
+  // needs no special case.
+  void Allocate() {
+    std::vector<size_t> numNodes;
+    size_t numPositions = m_size + 1;
+    do {
+      numPositions = (numPositions + B - 1) / B;
+      numNodes.push_back(numPositions);
+    } while (numPositions > 1);
+
+    m_offsets.resize(numNodes.size());
+    size_t offset = 0;
+    for (size_t level = numNodes.size(); level-- > 0;) {
+      m_offsets[level] = offset;
+      offset += numNodes[level];
+    }
+    m_nodes.resize(offset);
+  }
+
+  size_t NumNodes(size_t level) const {
+    return (level == 0 ? m_nodes.size() : m_offsets[level - 1]) - m_offsets[level];
+  }
+
+  size_t m_size{};
+
+  // Offsets of levels in |m_nodes|, level 0 holds leaves.
+  std::vector<size_t> m_offsets;
+  std::vector<Node> m_nodes;
+};
+}  // namespace algo
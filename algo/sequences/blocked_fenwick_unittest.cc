@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include "sequences/blocked_fenwick.h"
+#include "sequences/fenwick.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace algo {
+
+TEST(BlockedFenwick, Empty) {
+  BlockedFenwick<int> fenwick(0);
+  ASSERT_EQ(0u, fenwick.Size());
+  ASSERT_EQ(0, fenwick.Sum(0));
+  ASSERT_EQ(0u, fenwick.LowerBound(1));
+}
+
+template <size_t B>
+void TestRandom() {
+  std::mt19937 engine(0 /* seed */);
+  for (const size_t size : {1, 2, 7, 8, 9, 63, 64, 65, 1000}) {
+    std::vector<int64_t> values(size);
+    for (auto& value : values)
+      value = static_cast<int64_t>(engine() % 100) - 50;
+
+    BlockedFenwick<int64_t, B> built(values);
+    BlockedFenwick<int64_t, B> added(size);
+    Fenwick<int64_t> expected(values);
+    for (size_t index = 0; index < size; ++index)
+      added.Add(index, values[index]);
+
+    for (size_t i = 0; i < 2 * size; ++i) {
+      const size_t index = engine() % size;
+      const int64_t value = static_cast<int64_t>(engine() % 100) - 50;
+      built.Add(index, value);
+      added.Add(index, value);
+      expected.Add(index, value);
+
+      const size_t from = engine() % (size + 1);
+      const size_t to = from + engine() % (size - from + 1);
+      ASSERT_EQ(expected.Sum(from, to), built.Sum(from, to));
+      ASSERT_EQ(expected.Sum(from, to), added.Sum(from, to));
+    }
+    for (size_t to = 0; to <= size; ++to)
+      ASSERT_EQ(expected.Sum(to), built.Sum(to));
+  }
+}
+
+TEST(BlockedFenwick, Random) {
+  TestRandom<2>();
+  TestRandom<4>();
+  TestRandom<8>();
+  TestRandom<16>();
+}
+
+TEST(BlockedFenwick, Floating) {
+  BlockedFenwick<double> fenwick(100);
+  for (size_t index = 0; index < 100; ++index)
+    fenwick.Add(index, 0.5);
+  fenwick.Add(42, 1.0);
+  ASSERT_DOUBLE_EQ(21.0, fenwick.Sum(42));
+  ASSERT_DOUBLE_EQ(22.5, fenwick.Sum(43));
+  ASSERT_DOUBLE_EQ(51.0, fenwick.Sum(100));
+}
+
+TEST(BlockedFenwick, LowerBound) {
+  std::mt19937 engine(0 /* seed */);
+  for (const size_t size : {1, 5, 64, 1000}) {
+    std::vector<uint32_t> weights(size);
+    for (auto& weight : weights)
+      weight = engine() % 4;
+    const BlockedFenwick<uint32_t> blocked(weights);
+    const Fenwick<uint32_t> fenwick(weights);
+
+    const auto total = fenwick.Sum(size);
+    for (uint32_t target = 0; target <= total + 1; ++target)
+      ASSERT_EQ(fenwick.LowerBound(target), blocked.LowerBound(target));
+  }
+}
+
+// Sizes where the last node of each level is partly filled, and
+// targets past the total, which must not descend past real nodes.
+TEST(BlockedFenwick, LowerBoundPartialNodes) {
+  for (const size_t size : {2, 15, 17, 100, 300}) {
+    const std::vector<uint32_t> weights(size, 1);
+    const BlockedFenwick<uint32_t, 4> blocked(weights);
+    for (uint32_t target = 1; target <= size; ++target)
+      ASSERT_EQ(target - 1, blocked.LowerBound(target));
+    ASSERT_EQ(size, blocked.LowerBound(static_cast<uint32_t>(size) + 1));
+    ASSERT_EQ(size, blocked.LowerBound(UINT32_MAX));
+  }
+}
+
+}  // namespace algo
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace algo {
+// Monotone priority queue over integer keys from a sliding window,
+// a.k.a. Dial's buckets or a timer wheel: keys of all items must lie
+// within [m, m + |maxSpread|], where m is the key of the last Min().
+// For Dijkstra this holds with the max edge weight as a spread.
+//
+// There is a circular array of buckets, one per key, so Push() and
+// Pop() are O(1), and Min() skips empty buckets, which amounts to
+// O(C) in total over a run, where C is the max key.
+template <typename T>
+class BucketQueue {
+public:
+  using Item = std::pair<uint64_t /* key */, T /* value */>;
+
+  explicit BucketQueue(uint64_t maxSpread)
+      : m_buckets(std::bit_ceil(maxSpread + 1)), m_mask(m_buckets.size() - 1) {}
+
+  // Complexity: O(1).
+  void Push(const Item& item) {
+    assert(item.first >= m_cur && item.first - m_cur <= m_mask);
+    m_buckets[item.first & m_mask].push_back(item);
+    ++m_size;
+  }
+
+  // Returns an item with the min key. It's not const, as the current
+  // bucket is advanced lazily.
+  // Complexity: O(1) amortized, plus the number of skipped keys.
+  const Item& Min() {
+    assert(!Empty());
+    while (m_buckets[m_cur & m_mask].empty())
+      ++m_cur;
+    return m_buckets[m_cur & m_mask].back();
+  }
+
+  void Pop() {
+    Min();
+    m_buckets[m_cur & m_mask].pop_back();
+    --m_size;
+  }
+
+  size_t Size() const { return m_size; }
+  bool Empty() const { return m_size == 0; }
+
+private:
+  std::vector<std::vector<Item>> m_buckets;
+  uint64_t m_mask = 0;
+
+  // Key of the current bucket.
+  uint64_t m_cur = 0;
+  size_t m_size = 0;
+};
+}  // namespace algo
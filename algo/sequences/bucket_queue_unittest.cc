@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include "sequences/bucket_queue.h"
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace algo {
+
+TEST(BucketQueue, Smoke) {
+  BucketQueue<int> queue(10 /* maxSpread */);
+  ASSERT_TRUE(queue.Empty());
+
+  queue.Push({0, 1});
+  queue.Push({10, 2});
+  queue.Push({5, 3});
+  ASSERT_EQ(3u, queue.Size());
+
+  ASSERT_EQ(0u, queue.Min().first);
+  queue.Pop();
+  ASSERT_EQ(5u, queue.Min().first);
+  ASSERT_EQ(3, queue.Min().second);
+  queue.Push({12, 4});
+  queue.Pop();
+  ASSERT_EQ(10u, queue.Min().first);
+  queue.Pop();
+  ASSERT_EQ(12u, queue.Min().first);
+  queue.Pop();
+  ASSERT_TRUE(queue.Empty());
+}
+
+TEST(BucketQueue, Random) {
+  std::mt19937_64 engine(0 /* seed */);
+  for (const uint64_t maxSpread : {0, 1, 7, 100}) {
+    BucketQueue<uint32_t> queue(maxSpread);
+    std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>> expected;
+    uint64_t last = 0;
+    for (uint32_t i = 0; i < 10000; ++i) {
+      if (engine() % 3 != 0 || expected.empty()) {
+        const uint64_t key = last + engine() % (maxSpread + 1);
+        queue.Push({key, i});
+        expected.push(key);
+      } else {
+        last = queue.Min().first;
+        ASSERT_EQ(expected.top(), last);
+        queue.Pop();
+        expected.pop();
+      }
+      ASSERT_EQ(expected.size(), queue.Size());
+    }
+  }
+}
+
+}  // namespace algo
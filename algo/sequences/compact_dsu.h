@@ -0,0 +1,64 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace algo {
+// Same as DSU, but parents and sizes are packed into a single array
+// of 32-bit integers: a non-negative entry is a parent of a node,
+// while a negative one marks a root and holds minus size of its
+// component. Thus a step of find touches a single cache line. Finds
+// are iterative with path halving and unions are by size, so there is
+// no recursion on long chains.
+struct CompactDSU {
+  explicit CompactDSU(uint32_t n) : m_nodes(n, -1), m_numComponents(n) { assert(n <= INT32_MAX); }
+
+  void Clear() {
+    std::fill(m_nodes.begin(), m_nodes.end(), -1);
+    m_numComponents = static_cast<uint32_t>(m_nodes.size());
+  }
+
+  // Returns root of the component of |u|. Each visited node is
+  // relinked to its grandparent.
+  uint32_t GetParent(uint32_t u) {
+    while (true) {
+      const int32_t p = m_nodes[u];
+      if (p < 0)
+        return u;
+      const int32_t g = m_nodes[p];
+      if (g < 0)
+        return p;
+      m_nodes[u] = g;
+      u = g;
+    }
+  }
+
+  bool Union(uint32_t u, uint32_t v) {
+    u = GetParent(u);
+    v = GetParent(v);
+    if (u == v)
+      return false;
+
+    // Sizes are negative, so |u| becomes the larger component.
+    if (m_nodes[u] > m_nodes[v])
+      std::swap(u, v);
+    m_nodes[u] += m_nodes[v];
+    m_nodes[v] = u;
+
+    --m_numComponents;
+
+    return true;
+  }
+
+  // Returns size of the component of |u|.
+  uint32_t Size(uint32_t u) { return -m_nodes[GetParent(u)]; }
+
+  uint32_t NumComponents() const { return m_numComponents; }
+
+  std::vector<int32_t> m_nodes;
+  uint32_t m_numComponents{};
+};
+}  // namespace algo
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include "sequences/compact_dsu.h"
+#include "sequences/dsu.h"
+
+#include <cstdint>
+#include <random>
+
+using namespace algo;
+
+namespace {
+TEST(CompactDSU, Small) {
+  CompactDSU dsu{5};
+  for (uint32_t i = 0; i < 5; ++i)
+    ASSERT_EQ(dsu.GetParent(i), i);
+
+  ASSERT_FALSE(dsu.Union(2, 2));
+  ASSERT_TRUE(dsu.Union(2, 3));
+  ASSERT_EQ(dsu.GetParent(2), dsu.GetParent(3));
+  ASSERT_EQ(2u, dsu.Size(3));
+  ASSERT_EQ(4u, dsu.NumComponents());
+
+  dsu.Clear();
+  ASSERT_EQ(5u, dsu.NumComponents());
+  ASSERT_NE(dsu.GetParent(2), dsu.GetParent(3));
+}
+
+TEST(CompactDSU, LongChain) {
+  const uint32_t n = 1000000;
+  CompactDSU dsu{n};
+  // Links nodes into a chain directly, which union by size never
+  // produces, to check that finds do not recurse.
+  for (uint32_t i = 0; i + 1 < n; ++i)
+    dsu.m_nodes[i] = i + 1;
+  dsu.m_nodes[n - 1] = -static_cast<int32_t>(n);
+  ASSERT_EQ(n - 1, dsu.GetParent(0));
+  ASSERT_EQ(n, dsu.Size(0));
+}
+
+TEST(CompactDSU, Random) {
+  const uint32_t n = 1000;
+  std::mt19937 engine(0 /* seed */);
+  DSU expected{n};
+  CompactDSU dsu{n};
+  for (int i = 0; i < 2000; ++i) {
+    const uint32_t u = engine() % n;
+    const uint32_t v = engine() % n;
+    ASSERT_EQ(expected.Union(u, v), dsu.Union(u, v));
+    ASSERT_EQ(expected.NumComponents(), dsu.NumComponents());
+
+    const uint32_t a = engine() % n;
+    const uint32_t b = engine() % n;
+    ASSERT_EQ(expected.GetParent(a) == expected.GetParent(b), dsu.GetParent(a) == dsu.GetParent(b));
+  }
+}
+}  // namespace
@@ -0,0 +1,40 @@
+#include "sequences/concurrent_dsu.h"
+
+#include <algorithm>
+
+namespace algo {
+uint32_t ConcurrentDSU::NumComponents() const {
+  uint32_t numComponents = 0;
+  for (uint32_t u = 0; u < m_parent.size(); ++u)
+    numComponents += m_parent[u].load(std::memory_order_relaxed) == u;
+  return numComponents;
+}
+
+uint64_t ParallelUnite(ConcurrentDSU& dsu, std::span<const std::pair<uint32_t, uint32_t>> edges,
+                       unsigned numThreads) {
+  numThreads = std::max(numThreads, 1u);
+  const size_t chunkSize = (edges.size() + numThreads - 1) / numThreads;
+
+  std::vector<uint64_t> unions(numThreads);
+  auto unite = [&](unsigned t) {
+    const size_t from = std::min(t * chunkSize, edges.size());
+    const size_t to = std::min(from + chunkSize, edges.size());
+    uint64_t count = 0;
+    for (size_t i = from; i < to; ++i)
+      count += dsu.Union(edges[i].first, edges[i].second);
+    unions[t] = count;
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned t = 1; t < numThreads; ++t)
+    threads.emplace_back(unite, t);
+  unite(0);
+  for (auto& thread : threads)
+    thread.join();
+
+  uint64_t total = 0;
+  for (const auto count : unions)
+    total += count;
+  return total;
+}
+}  // namespace algo
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace algo {
+// Lock-free DSU, all methods may be called concurrently. Parent links
+// are changed by CAS only: a root is linked under another root iff it
+// is still a root, and finds do path halving by CAS as well, ignoring
+// failures. Roots are linked by a fixed random-like priority of nodes
+// instead of sizes or ranks, which keeps expected tree height
+// logarithmic without extra shared state.
+//
+// See S. Jayanti, R. Tarjan, "A Randomized Concurrent Algorithm for
+// Disjoint Set Union".
+class ConcurrentDSU {
+public:
+  explicit ConcurrentDSU(uint32_t n) : m_parent(n) {
+    for (uint32_t i = 0; i < n; ++i)
+      m_parent[i].store(i, std::memory_order_relaxed);
+  }
+
+  // Returns root of the component of |u|. Under concurrent unions the
+  // root may be outdated by the time it is returned.
+  uint32_t GetParent(uint32_t u) {
+    while (true) {
+      uint32_t p = m_parent[u].load();
+      if (p == u)
+        return u;
+      const uint32_t g = m_parent[p].load();
+      if (g == p)
+        return p;
+      m_parent[u].compare_exchange_weak(p, g);
+      u = g;
+    }
+  }
+
+  // Unites components of |u| and |v|. Returns true iff they were
+  // different.
+  bool Union(uint32_t u, uint32_t v) {
+    while (true) {
+      u = GetParent(u);
+      v = GetParent(v);
+      if (u == v)
+        return false;
+      if (Priority(u) > Priority(v))
+        std::swap(u, v);
+      // Fails iff |u| is not a root anymore, then retries from
+      // current roots.
+      if (m_parent[u].compare_exchange_strong(u, v))
+        return true;
+    }
+  }
+
+  // Returns true iff |u| and |v| are in the same component.
+  bool SameSet(uint32_t u, uint32_t v) {
+    while (true) {
+      u = GetParent(u);
+      v = GetParent(v);
+      if (u == v)
+        return true;
+      // Components were different at the moment when |u| was still a
+      // root after |v| was found.
+      if (m_parent[u].load() == u)
+        return false;
+    }
+  }
+
+  // Returns number of components.
+  // Complexity: O(n), should not be called concurrently with unions.
+  uint32_t NumComponents() const;
+
+  uint32_t Size() const { return m_parent.size(); }
+
+private:
+  // Bijection on 32-bit integers that scatters consecutive nodes.
+  static uint32_t Priority(uint32_t u) { return u * 0x9E3779B1u; }
+
+  std::vector<std::atomic<uint32_t>> m_parent;
+};
+
+// Unites all |edges| in |dsu| by |numThreads| threads, each working
+// on a contiguous range of |edges|. Returns number of successful
+// unions.
+uint64_t ParallelUnite(ConcurrentDSU& dsu, std::span<const std::pair<uint32_t, uint32_t>> edges,
+                       unsigned numThreads = std::thread::hardware_concurrency());
+}  // namespace algo
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include "sequences/compact_dsu.h"
+#include "sequences/concurrent_dsu.h"
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace algo;
+
+namespace {
+TEST(ConcurrentDSU, Small) {
+  ConcurrentDSU dsu{5};
+  for (uint32_t i = 0; i < 5; ++i)
+    ASSERT_EQ(dsu.GetParent(i), i);
+
+  ASSERT_FALSE(dsu.Union(2, 2));
+  ASSERT_TRUE(dsu.Union(2, 3));
+  ASSERT_FALSE(dsu.Union(3, 2));
+  ASSERT_EQ(dsu.GetParent(2), dsu.GetParent(3));
+  ASSERT_TRUE(dsu.SameSet(2, 3));
+  ASSERT_FALSE(dsu.SameSet(1, 3));
+  ASSERT_EQ(4u, dsu.NumComponents());
+}
+
+TEST(ConcurrentDSU, ParallelUnite) {
+  const uint32_t n = 100000;
+  std::mt19937 engine(0 /* seed */);
+  std::vector<std::pair<uint32_t, uint32_t>> edges(n);
+  for (auto& [u, v] : edges) {
+    u = engine() % n;
+    v = engine() % n;
+  }
+
+  CompactDSU expected{n};
+  for (const auto& [u, v] : edges)
+    expected.Union(u, v);
+
+  for (const unsigned numThreads : {1, 2, 8}) {
+    ConcurrentDSU dsu{n};
+    ASSERT_EQ(n - expected.NumComponents(), ParallelUnite(dsu, edges, numThreads));
+    ASSERT_EQ(expected.NumComponents(), dsu.NumComponents());
+    for (uint32_t i = 0; i < 1000; ++i) {
+      const uint32_t u = engine() % n;
+      const uint32_t v = engine() % n;
+      ASSERT_EQ(expected.GetParent(u) == expected.GetParent(v), dsu.SameSet(u, v));
+    }
+  }
+}
+}  // namespace
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace algo {
+namespace impl {
+// Allocates memory so that the element with the index 1 starts a
+// cache line. As children of a node in a d-ary heap start at indices
+// d * i + 1, each group of siblings is then aligned to cache lines.
+template <typename T>
+struct SiblingAlignedAllocator {
+  using value_type = T;
+
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+  static constexpr size_t SHIFT = (CACHE_LINE_SIZE - sizeof(T) % CACHE_LINE_SIZE) % CACHE_LINE_SIZE;
+
+  SiblingAlignedAllocator() = default;
+
+  template <typename U>
+  SiblingAlignedAllocator(const SiblingAlignedAllocator<U>&) {}
+
+  T* allocate(size_t n) {
+    auto* base = static_cast<std::byte*>(::operator new(n * sizeof(T) + SHIFT, std::align_val_t{CACHE_LINE_SIZE}));
+    return reinterpret_cast<T*>(base + SHIFT);
+  }
+
+  void deallocate(T* p, size_t) {
+    ::operator delete(reinterpret_cast<std::byte*>(p) - SHIFT, std::align_val_t{CACHE_LINE_SIZE});
+  }
+
+  template <typename U>
+  bool operator==(const SiblingAlignedAllocator<U>&) const {
+    return true;
+  }
+};
+}  // namespace impl
+
+// Same interface as Heap, but each node has |Arity| children, which
+// are stored contiguously and aligned to cache lines. Compared to the
+// binary heap, the tree is log2(Arity) times lower, and all children
+// of a node are compared within a single cache line, when Arity *
+// sizeof(T) <= 64.
+//
+// Elements are moved to holes instead of being swapped, and Pop()
+// uses Floyd's trick: the hole at the root is sifted down to a leaf
+// without comparisons against the last element, which is then sifted
+// up, usually by a few levels only.
+template <typename T, size_t Arity = 4>
+class DaryHeap {
+public:
+  static_assert(Arity >= 2);
+
+  DaryHeap() = default;
+
+  // Replaces content of the heap with |values|.
+  // Complexity: O(n).
+  void Build(std::span<const T> values);
+
+  template <typename V>
+  void Push(V&& value);
+  void Pop();
+
+  const T& Min() const { return m_buffer[0]; }
+  T& Min() { return m_buffer[0]; }
+
+  const T& operator[](size_t i) const { return m_buffer[i]; }
+  T& operator[](size_t i) { return m_buffer[i]; }
+
+  size_t Size() const { return m_buffer.size(); }
+  bool Empty() const { return m_buffer.empty(); }
+
+  void OnValueDecreased(size_t pos);
+  void OnValueIncreased(size_t pos);
+
+private:
+  static size_t FirstChild(size_t pos) { return Arity * pos + 1; }
+  static size_t Parent(size_t pos) { return (pos - 1) / Arity; }
+
+  // Returns position of the min child of |pos|. The node must have at
+  // least one child.
+  size_t MinChild(size_t pos) const;
+
+  // Moves |value| to the hole at |pos| or to one of its ancestors.
+  void SiftUp(size_t pos, T value);
+
+  std::vector<T, impl::SiblingAlignedAllocator<T>> m_buffer;
+};
+
+template <typename T, size_t Arity>
+void DaryHeap<T, Arity>::Build(std::span<const T> values) {
+  m_buffer.assign(values.begin(), values.end());
+  if (m_buffer.size() < 2)
+    return;
+  for (size_t pos = Parent(m_buffer.size() - 1) + 1; pos-- > 0;)
+    OnValueIncreased(pos);
+}
+
+template <typename T, size_t Arity>
+template <typename V>
+void DaryHeap<T, Arity>::Push(V&& value) {
+  m_buffer.push_back(std::forward<V>(value));
+  OnValueDecreased(Size() - 1);
+}
+
+template <typename T, size_t Arity>
+void DaryHeap<T, Arity>::Pop() {
+  assert(!Empty());
+  T last = std::move(m_buffer.back());
+  m_buffer.pop_back();
+  if (Empty())
+    return;
+
+  size_t pos = 0;
+  while (FirstChild(pos) < m_buffer.size()) {
+    // Grandchildren of |pos| are contiguous, so the next level is
+    // fetched while children are compared.
+    const auto grandchildren = FirstChild(FirstChild(pos));
+    if (grandchildren < m_buffer.size()) {
+      for (size_t i = 0; i < Arity * Arity * sizeof(T); i += 64)
+        __builtin_prefetch(reinterpret_cast<const char*>(&m_buffer[grandchildren]) + i);
+    }
+    const auto child = MinChild(pos);
+    m_buffer[pos] = std::move(m_buffer[child]);
+    pos = child;
+  }
+  SiftUp(pos, std::move(last));
+}
+
+template <typename T, size_t Arity>
+void DaryHeap<T, Arity>::OnValueDecreased(size_t pos) {
+  if (pos == 0 || !(m_buffer[pos] < m_buffer[Parent(pos)]))
+    return;
+  SiftUp(pos, std::move(m_buffer[pos]));
+}
+
+template <typename T, size_t Arity>
+void DaryHeap<T, Arity>::OnValueIncreased(size_t pos) {
+  if (FirstChild(pos) >= m_buffer.size())
+    return;
+
+  T value = std::move(m_buffer[pos]);
+  while (FirstChild(pos) < m_buffer.size()) {
+    const auto child = MinChild(pos);
+    if (!(m_buffer[child] < value))
+      break;
+    m_buffer[pos] = std::move(m_buffer[child]);
+    pos = child;
+  }
+  m_buffer[pos] = std::move(value);
+}
+
+template <typename T, size_t Arity>
+size_t DaryHeap<T, Arity>::MinChild(size_t pos) const {
+  const auto first = FirstChild(pos);
+  size_t best = first;
+  if (first + Arity <= m_buffer.size()) {
+    // A separate loop with a constant number of iterations for
+    // internal nodes, which the compiler fully unrolls.
+    for (size_t i = 1; i < Arity; ++i) {
+      if (m_buffer[first + i] < m_buffer[best])
+        best = first + i;
+    }
+    return best;
+  }
+
+  for (size_t i = first + 1; i < m_buffer.size(); ++i) {
+    if (m_buffer[i] < m_buffer[best])
+      best = i;
+  }
+  return best;
+}
+
+template <typename T, size_t Arity>
+void DaryHeap<T, Arity>::SiftUp(size_t pos, T value) {
+  while (pos != 0) {
+    const auto parent = Parent(pos);
+    if (!(value < m_buffer[parent]))
+      break;
+    m_buffer[pos] = std::move(m_buffer[parent]);
+    pos = parent;
+  }
+  m_buffer[pos] = std::move(value);
+}
+}  // namespace algo
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include "sequences/dary_heap.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace algo {
+namespace {
+// A simple movable-only wrapper around int.
+class Foo {
+public:
+  Foo(int value) : m_value(new int(value)) {}
+  Foo(Foo&& foo) = default;
+  Foo& operator=(Foo&& foo) = default;
+
+  bool operator<(const Foo& rhs) const { return Value() < rhs.Value(); }
+
+  int Value() const { return *m_value; }
+
+private:
+  std::unique_ptr<int> m_value;
+};
+
+template <size_t Arity>
+void TestRandom() {
+  std::mt19937 engine(0 /* seed */);
+  DaryHeap<uint32_t, Arity> heap;
+  std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> expected;
+  for (int i = 0; i < 10000; ++i) {
+    if (engine() % 3 != 0 || expected.empty()) {
+      const auto value = static_cast<uint32_t>(engine() % 1000);
+      heap.Push(value);
+      expected.push(value);
+    } else {
+      heap.Pop();
+      expected.pop();
+    }
+    ASSERT_EQ(expected.size(), heap.Size());
+    if (!expected.empty()) {
+      ASSERT_EQ(expected.top(), heap.Min());
+    }
+  }
+}
+}  // namespace
+
+TEST(DaryHeap, Smoke) {
+  DaryHeap<Foo> heap;
+  ASSERT_EQ(0u, heap.Size());
+  ASSERT_TRUE(heap.Empty());
+
+  for (int value : {5, 2, 7, 1, 0, 3, 6, 4})
+    heap.Push(Foo(value));
+  ASSERT_EQ(8u, heap.Size());
+
+  for (int i = 0; i < 8; ++i) {
+    ASSERT_EQ(i, heap.Min().Value());
+    heap.Pop();
+  }
+  ASSERT_TRUE(heap.Empty());
+}
+
+TEST(DaryHeap, Random) {
+  TestRandom<2>();
+  TestRandom<3>();
+  TestRandom<4>();
+  TestRandom<8>();
+}
+
+TEST(DaryHeap, Build) {
+  std::mt19937 engine(0 /* seed */);
+  for (const size_t size : {0, 1, 2, 5, 17, 1000}) {
+    std::vector<uint64_t> values(size);
+    for (auto& value : values)
+      value = engine() % 100;
+
+    DaryHeap<uint64_t, 8> heap;
+    heap.Push(uint64_t{1000});
+    heap.Build(values);
+    ASSERT_EQ(size, heap.Size());
+
+    std::sort(values.begin(), values.end());
+    for (const auto value : values) {
+      ASSERT_EQ(value, heap.Min());
+      heap.Pop();
+    }
+    ASSERT_TRUE(heap.Empty());
+  }
+}
+
+TEST(DaryHeap, ChangeValues) {
+  std::mt19937 engine(0 /* seed */);
+  std::vector<int> values(500);
+  for (auto& value : values)
+    value = static_cast<int>(engine() % 1000);
+
+  DaryHeap<int> heap;
+  heap.Build(values);
+  for (int i = 0; i < 1000; ++i) {
+    const size_t pos = engine() % heap.Size();
+    const int delta = static_cast<int>(engine() % 100);
+    if (engine() % 2 == 0) {
+      heap[pos] -= delta;
+      heap.OnValueDecreased(pos);
+    } else {
+      heap[pos] += delta;
+      heap.OnValueIncreased(pos);
+    }
+  }
+
+  std::vector<int> popped;
+  while (!heap.Empty()) {
+    popped.push_back(heap.Min());
+    heap.Pop();
+  }
+  ASSERT_EQ(values.size(), popped.size());
+  ASSERT_TRUE(std::is_sorted(popped.begin(), popped.end()));
+}
+
+TEST(DaryHeap, SiblingsAreAligned) {
+  DaryHeap<uint64_t, 8> heap;
+  for (uint64_t i = 0; i < 100; ++i)
+    heap.Push(i);
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(&heap[1]) % 64);
+}
+
+}  // namespace algo
@@ -1,15 +1,37 @@
 #pragma once
 
+#include <bit>
 #include <cassert>
 #include <cstddef>
+#include <span>
 #include <vector>
 
 namespace algo {
+// Index arithmetic shared by all Fenwick trees. Node |index| holds a
+// sum over [F(|index|), |index|], and G(|index|) is the next node
+// covering |index|.
+class FenwickBase {
+protected:
+  static size_t F(size_t index) { return index & (index + 1); }
+  static size_t G(size_t index) { return index | (index + 1); }
+};
+
 template <typename T>
-class Fenwick {
+class Fenwick : private FenwickBase {
 public:
   explicit Fenwick(size_t size) : m_buffer(size) {}
 
+  // Builds tree over |values|. Each node pushes its sum to the parent
+  // exactly once, so this takes O(n) instead of O(n log n) for Add()
+  // calls.
+  explicit Fenwick(std::span<const T> values) : m_buffer(values.begin(), values.end()) {
+    for (size_t index = 0; index < m_buffer.size(); ++index) {
+      const auto parent = G(index);
+      if (parent < m_buffer.size())
+        m_buffer[parent] += m_buffer[index];
+    }
+  }
+
   // Adds |value| to an element on a position |index|.
   void Add(size_t index, const T& value) {
     assert(index < m_buffer.size());
@@ -41,12 +63,238 @@ public:
     return Sum(to) - Sum(from);
   }
 
+  // Returns the smallest |index| such that Sum(|index| + 1) >=
+  // |target|, or Size() when there is no such index. All elements
+  // should be non-negative. Descends the tree once, in contrast to a
+  // binary search over Sum().
+  // Complexity: O(log n).
+  size_t LowerBound(T target) const {
+    size_t pos = 0;
+    for (size_t step = std::bit_floor(m_buffer.size()); step != 0; step /= 2) {
+      // |pos| is a multiple of 2 * |step|, so this node covers exactly
+      // [|pos|, |pos| + |step|).
+      const auto node = pos + step - 1;
+      if (node < m_buffer.size() && m_buffer[node] < target) {
+        target -= m_buffer[node];
+        pos += step;
+      }
+    }
+    return pos;
+  }
+
   size_t Size() const { return m_buffer.size(); }
 
 private:
-  static size_t F(size_t index) { return index & (index + 1); }
-  static size_t G(size_t index) { return index | (index + 1); }
+  std::vector<T> m_buffer;
+};
+
+// Fenwick tree with range additions and range sums. An addition of
+// |value| to [|from|, |to|) is a pair of suffix additions, and a
+// suffix addition of d at i contributes d * (x - i) to the prefix sum
+// of length x > i. Thus Sum(x) = x * D(x) - I(x), where D and I are
+// plain Fenwick sums over d and d * i. Both are kept in the same
+// node, so a step of the tree touches a single cache line.
+template <typename T>
+class RangeFenwick : private FenwickBase {
+public:
+  explicit RangeFenwick(size_t size) : m_nodes(size) {}
+
+  // Adds |value| to all elements on a range [|from|, |to|).
+  // Complexity: O(log n).
+  void Add(size_t from, size_t to, const T& value) {
+    assert(from <= to);
+    assert(to <= m_nodes.size());
+    AddSuffix(from, value);
+    AddSuffix(to, -value);
+  }
+
+  // Returns sum on a range [0, |to|).
+  // Complexity: O(log n).
+  T Sum(size_t to) const {
+    assert(to <= m_nodes.size());
+
+    T d{};
+    T id{};
+    for (size_t index = to; index != 0;) {
+      --index;
+      d += m_nodes[index].m_d;
+      id += m_nodes[index].m_id;
+      index = F(index);
+    }
+    return d * static_cast<T>(to) - id;
+  }
+
+  // Returns sum on a range [|from|, |to|).
+  T Sum(size_t from, size_t to) const {
+    assert(from <= to);
+    if (from == to)
+      return T{};
+    return Sum(to) - Sum(from);
+  }
+
+  size_t Size() const { return m_nodes.size(); }
+
+private:
+  struct Node {
+    T m_d{};
+    T m_id{};
+  };
+
+  void AddSuffix(size_t index, const T& value) {
+    const auto id = value * static_cast<T>(index);
+    for (; index < m_nodes.size(); index = G(index)) {
+      m_nodes[index].m_d += value;
+      m_nodes[index].m_id += id;
+    }
+  }
+
+  std::vector<Node> m_nodes;
+};
+
+// 2D Fenwick tree with point additions and rectangle sums. Nodes are
+// stored row by row, so the inner loop over columns stays within a
+// single row, where first steps of G() and F() share cache lines.
+template <typename T>
+class Fenwick2D : private FenwickBase {
+public:
+  Fenwick2D(size_t numRows, size_t numCols) : m_numRows{numRows}, m_numCols{numCols}, m_buffer(numRows * numCols) {}
+
+  // Adds |value| to an element at (|row|, |col|).
+  // Complexity: O(log(rows) * log(cols)).
+  void Add(size_t row, size_t col, const T& value) {
+    assert(row < NumRows());
+    assert(col < NumCols());
+    for (size_t i = row; i < m_numRows; i = G(i)) {
+      T* const nodes = m_buffer.data() + i * m_numCols;
+      for (size_t j = col; j < m_numCols; j = G(j))
+        nodes[j] += value;
+    }
+  }
 
+  // Returns sum over [0, |toRow|) x [0, |toCol|).
+  // Complexity: O(log(rows) * log(cols)).
+  T Sum(size_t toRow, size_t toCol) const {
+    assert(toRow <= NumRows());
+    assert(toCol <= NumCols());
+    T result{};
+    if (toRow == 0 || toCol == 0)
+      return result;
+    for (size_t i = toRow; i != 0;) {
+      --i;
+      const T* const nodes = m_buffer.data() + i * m_numCols;
+      for (size_t j = toCol; j != 0;) {
+        --j;
+        result += nodes[j];
+        j = F(j);
+      }
+      i = F(i);
+    }
+    return result;
+  }
+
+  // Returns sum over [|fromRow|, |toRow|) x [|fromCol|, |toCol|).
+  T Sum(size_t fromRow, size_t fromCol, size_t toRow, size_t toCol) const {
+    assert(fromRow <= toRow);
+    assert(fromCol <= toCol);
+    return Sum(toRow, toCol) - Sum(fromRow, toCol) - Sum(toRow, fromCol) + Sum(fromRow, fromCol);
+  }
+
+  size_t NumRows() const { return m_numRows; }
+  size_t NumCols() const { return m_numCols; }
+
+private:
+  size_t m_numRows{};
+  size_t m_numCols{};
   std::vector<T> m_buffer;
 };
+
+// 2D Fenwick tree with rectangle additions and rectangle sums. Same
+// as RangeFenwick, but in two dimensions: an addition of d to all
+// cells (i', j') with i' >= i, j' >= j contributes d * (x - i) * (y -
+// j) to the prefix sum over [0, x) x [0, y), so nodes keep sums of d,
+// d * i, d * j and d * i * j, next to each other. Nodes are stored
+// row by row, as in Fenwick2D.
+template <typename T>
+class RangeFenwick2D : private FenwickBase {
+public:
+  RangeFenwick2D(size_t numRows, size_t numCols)
+      : m_numRows{numRows}, m_numCols{numCols}, m_nodes(numRows * numCols) {}
+
+  // Adds |value| to all elements of [|fromRow|, |toRow|) x [|fromCol|,
+  // |toCol|).
+  // Complexity: O(log(rows) * log(cols)).
+  void Add(size_t fromRow, size_t fromCol, size_t toRow, size_t toCol, const T& value) {
+    assert(fromRow <= toRow && toRow <= NumRows());
+    assert(fromCol <= toCol && toCol <= NumCols());
+    AddSuffix(fromRow, fromCol, value);
+    AddSuffix(fromRow, toCol, -value);
+    AddSuffix(toRow, fromCol, -value);
+    AddSuffix(toRow, toCol, value);
+  }
+
+  // Returns sum over [0, |toRow|) x [0, |toCol|).
+  // Complexity: O(log(rows) * log(cols)).
+  T Sum(size_t toRow, size_t toCol) const {
+    assert(toRow <= NumRows());
+    assert(toCol <= NumCols());
+    if (toRow == 0 || toCol == 0)
+      return T{};
+    Node sum;
+    for (size_t i = toRow; i != 0;) {
+      --i;
+      const Node* const nodes = m_nodes.data() + i * m_numCols;
+      for (size_t j = toCol; j != 0;) {
+        --j;
+        const auto& node = nodes[j];
+        sum.m_d += node.m_d;
+        sum.m_id += node.m_id;
+        sum.m_jd += node.m_jd;
+        sum.m_ijd += node.m_ijd;
+        j = F(j);
+      }
+      i = F(i);
+    }
+    const auto x = static_cast<T>(toRow);
+    const auto y = static_cast<T>(toCol);
+    return sum.m_d * x * y - sum.m_id * y - sum.m_jd * x + sum.m_ijd;
+  }
+
+  // Returns sum over [|fromRow|, |toRow|) x [|fromCol|, |toCol|).
+  T Sum(size_t fromRow, size_t fromCol, size_t toRow, size_t toCol) const {
+    assert(fromRow <= toRow);
+    assert(fromCol <= toCol);
+    return Sum(toRow, toCol) - Sum(fromRow, toCol) - Sum(toRow, fromCol) + Sum(fromRow, fromCol);
+  }
+
+  size_t NumRows() const { return m_numRows; }
+  size_t NumCols() const { return m_numCols; }
+
+private:
+  struct Node {
+    T m_d{};
+    T m_id{};
+    T m_jd{};
+    T m_ijd{};
+  };
+
+  void AddSuffix(size_t row, size_t col, const T& value) {
+    const auto id = value * static_cast<T>(row);
+    const auto jd = value * static_cast<T>(col);
+    const auto ijd = id * static_cast<T>(col);
+    for (size_t i = row; i < m_numRows; i = G(i)) {
+      Node* const nodes = m_nodes.data() + i * m_numCols;
+      for (size_t j = col; j < m_numCols; j = G(j)) {
+        auto& node = nodes[j];
+        node.m_d += value;
+        node.m_id += id;
+        node.m_jd += jd;
+        node.m_ijd += ijd;
+      }
+    }
+  }
+
+  size_t m_numRows{};
+  size_t m_numCols{};
+  std::vector<Node> m_nodes;
+};
 }  // namespace algo
@@ -2,6 +2,11 @@
 
 #include "sequences/fenwick.h"
 
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
 namespace algo {
 
 TEST(Fenwick, Empty) {
@@ -39,4 +44,138 @@ TEST(Fenwick, Smoke) {
   }
 }
 
+TEST(Fenwick, Build) {
+  std::mt19937 engine(0 /* seed */);
+  for (const size_t size : {0, 1, 2, 7, 8, 100}) {
+    std::vector<int64_t> values(size);
+    for (auto& value : values)
+      value = static_cast<int64_t>(engine() % 100) - 50;
+
+    const Fenwick<int64_t> built(values);
+    Fenwick<int64_t> added(size);
+    for (size_t index = 0; index < size; ++index)
+      added.Add(index, values[index]);
+
+    for (size_t to = 0; to <= size; ++to)
+      ASSERT_EQ(added.Sum(to), built.Sum(to));
+  }
+}
+
+TEST(Fenwick, LowerBound) {
+  const std::vector<int> values{3, 0, 1, 0, 0, 4, 2};
+  const Fenwick<int> fenwick(values);
+  ASSERT_EQ(0u, fenwick.LowerBound(0));
+  ASSERT_EQ(0u, fenwick.LowerBound(3));
+  ASSERT_EQ(2u, fenwick.LowerBound(4));
+  ASSERT_EQ(5u, fenwick.LowerBound(5));
+  ASSERT_EQ(6u, fenwick.LowerBound(9));
+  ASSERT_EQ(6u, fenwick.LowerBound(10));
+  ASSERT_EQ(7u, fenwick.LowerBound(11));
+
+  std::mt19937 engine(0 /* seed */);
+  for (const size_t size : {1, 5, 64, 1000}) {
+    std::vector<uint64_t> weights(size);
+    for (auto& weight : weights)
+      weight = engine() % 4;
+    const Fenwick<uint64_t> tree(weights);
+
+    uint64_t total = 0;
+    for (const auto weight : weights)
+      total += weight;
+    for (uint64_t target = 0; target <= total + 1; ++target) {
+      size_t expected = 0;
+      uint64_t sum = 0;
+      while (expected < size && sum + weights[expected] < target)
+        sum += weights[expected++];
+      ASSERT_EQ(expected, tree.LowerBound(target));
+    }
+  }
+}
+
+TEST(Fenwick, RangeFenwick) {
+  std::mt19937 engine(0 /* seed */);
+  const size_t size = 50;
+  RangeFenwick<int64_t> fenwick(size);
+  std::vector<int64_t> values(size);
+  for (int i = 0; i < 500; ++i) {
+    size_t from = engine() % (size + 1);
+    size_t to = engine() % (size + 1);
+    if (from > to)
+      std::swap(from, to);
+    const int64_t value = static_cast<int64_t>(engine() % 21) - 10;
+    fenwick.Add(from, to, value);
+    for (size_t j = from; j < to; ++j)
+      values[j] += value;
+
+    from = engine() % (size + 1);
+    to = engine() % (size + 1);
+    if (from > to)
+      std::swap(from, to);
+    int64_t expected = 0;
+    for (size_t j = from; j < to; ++j)
+      expected += values[j];
+    ASSERT_EQ(expected, fenwick.Sum(from, to));
+  }
+}
+
+TEST(Fenwick, Fenwick2D) {
+  std::mt19937 engine(0 /* seed */);
+  const size_t numRows = 13;
+  const size_t numCols = 21;
+  Fenwick2D<int64_t> fenwick(numRows, numCols);
+  RangeFenwick2D<int64_t> rangeFenwick(numRows, numCols);
+  std::vector<std::vector<int64_t>> points(numRows, std::vector<int64_t>(numCols));
+  std::vector<std::vector<int64_t>> rects(numRows, std::vector<int64_t>(numCols));
+
+  auto randomRange = [&](size_t size) {
+    size_t from = engine() % (size + 1);
+    size_t to = engine() % (size + 1);
+    if (from > to)
+      std::swap(from, to);
+    return std::pair{from, to};
+  };
+
+  for (int i = 0; i < 300; ++i) {
+    const size_t row = engine() % numRows;
+    const size_t col = engine() % numCols;
+    const int64_t value = static_cast<int64_t>(engine() % 21) - 10;
+    fenwick.Add(row, col, value);
+    points[row][col] += value;
+
+    {
+      const auto [fromRow, toRow] = randomRange(numRows);
+      const auto [fromCol, toCol] = randomRange(numCols);
+      rangeFenwick.Add(fromRow, fromCol, toRow, toCol, value);
+      for (size_t r = fromRow; r < toRow; ++r) {
+        for (size_t c = fromCol; c < toCol; ++c)
+          rects[r][c] += value;
+      }
+    }
+
+    const auto [fromRow, toRow] = randomRange(numRows);
+    const auto [fromCol, toCol] = randomRange(numCols);
+    int64_t pointSum = 0;
+    int64_t rectSum = 0;
+    for (size_t r = fromRow; r < toRow; ++r) {
+      for (size_t c = fromCol; c < toCol; ++c) {
+        pointSum += points[r][c];
+        rectSum += rects[r][c];
+      }
+    }
+    ASSERT_EQ(pointSum, fenwick.Sum(fromRow, fromCol, toRow, toCol));
+    ASSERT_EQ(rectSum, rangeFenwick.Sum(fromRow, fromCol, toRow, toCol));
+  }
+}
+
+TEST(Fenwick, Fenwick2DEmpty) {
+  for (const auto& [numRows, numCols] : {std::pair<size_t, size_t>{0, 0}, {0, 5}, {5, 0}}) {
+    Fenwick2D<int> fenwick(numRows, numCols);
+    RangeFenwick2D<int> rangeFenwick(numRows, numCols);
+    rangeFenwick.Add(0, 0, numRows, numCols, 1);
+    ASSERT_EQ(0, fenwick.Sum(numRows, numCols));
+    ASSERT_EQ(0, rangeFenwick.Sum(numRows, numCols));
+    ASSERT_EQ(0, rangeFenwick.Sum(0, 0, numRows, numCols));
+  }
+}
+
 }  // namespace algo
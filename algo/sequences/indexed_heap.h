@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "sequences/dary_heap.h"
+
+namespace algo {
+// Addressable d-ary min-heap over ids in [0, |numIds|), each with a
+// value. The heap keeps position of each id, so values of ids in the
+// heap may be changed and ids may be erased, which is what Dijkstra
+// and Prim algorithms need instead of lazy deletion with duplicated
+// entries.
+//
+// Entries keep ids next to values, so comparisons do not look into
+// the position map, which is touched only once per moved entry.
+template <typename T, size_t Arity = 4>
+class IndexedHeap {
+public:
+  static_assert(Arity >= 2);
+
+  explicit IndexedHeap(size_t numIds) : m_positions(numIds, NOT_IN_HEAP) { assert(numIds < NOT_IN_HEAP); }
+
+  // Returns true iff |id| is in the heap.
+  bool Contains(uint32_t id) const {
+    assert(id < m_positions.size());
+    return m_positions[id] != NOT_IN_HEAP;
+  }
+
+  // Returns value of |id|, which must be in the heap.
+  const T& Value(uint32_t id) const {
+    assert(Contains(id));
+    return m_entries[m_positions[id]].m_value;
+  }
+
+  // Adds |id| with |value|. The |id| must not be in the heap.
+  // Complexity: O(log n).
+  void Push(uint32_t id, const T& value) {
+    assert(!Contains(id));
+    m_entries.push_back(Entry{value, id});
+    SiftUp(m_entries.size() - 1, Entry{value, id});
+  }
+
+  // Sets value of |id| to |value|, which must not be greater than the
+  // current one.
+  // Complexity: O(log n).
+  void DecreaseKey(uint32_t id, const T& value) {
+    assert(Contains(id));
+    const auto pos = m_positions[id];
+    assert(!(m_entries[pos].m_value < value));
+    SiftUp(pos, Entry{value, id});
+  }
+
+  // Sets value of |id| to |value|, which must not be less than the
+  // current one.
+  // Complexity: O(Arity * log n).
+  void IncreaseKey(uint32_t id, const T& value) {
+    assert(Contains(id));
+    const auto pos = m_positions[id];
+    assert(!(value < m_entries[pos].m_value));
+    SiftDown(pos, Entry{value, id});
+  }
+
+  // Removes |id| from the heap, if it's there.
+  // Complexity: O(Arity * log n).
+  void Erase(uint32_t id) {
+    if (!Contains(id))
+      return;
+    const auto pos = m_positions[id];
+    m_positions[id] = NOT_IN_HEAP;
+
+    const Entry last = m_entries.back();
+    m_entries.pop_back();
+    if (pos == m_entries.size())
+      return;
+    if (pos != 0 && last.m_value < m_entries[Parent(pos)].m_value)
+      SiftUp(pos, last);
+    else
+      SiftDown(pos, last);
+  }
+
+  uint32_t MinId() const {
+    assert(!Empty());
+    return m_entries[0].m_id;
+  }
+
+  const T& MinValue() const {
+    assert(!Empty());
+    return m_entries[0].m_value;
+  }
+
+  // Removes the min entry.
+  // Complexity: O(Arity * log n).
+  void Pop() {
+    assert(!Empty());
+    Erase(MinId());
+  }
+
+  size_t Size() const { return m_entries.size(); }
+  bool Empty() const { return m_entries.empty(); }
+
+private:
+  static constexpr uint32_t NOT_IN_HEAP = UINT32_MAX;
+
+  struct Entry {
+    T m_value;
+    uint32_t m_id;
+  };
+
+  static size_t FirstChild(size_t pos) { return Arity * pos + 1; }
+  static size_t Parent(size_t pos) { return (pos - 1) / Arity; }
+
+  void Place(size_t pos, const Entry& entry) {
+    m_entries[pos] = entry;
+    m_positions[entry.m_id] = static_cast<uint32_t>(pos);
+  }
+
+  // Moves |entry| to the hole at |pos| or to one of its ancestors.
+  void SiftUp(size_t pos, const Entry& entry) {
+    while (pos != 0) {
+      const auto parent = Parent(pos);
+      if (!(entry.m_value < m_entries[parent].m_value))
+        break;
+      Place(pos, m_entries[parent]);
+      pos = parent;
+    }
+    Place(pos, entry);
+  }
+
+  // Moves |entry| to the hole at |pos| or to one of its descendants.
+  void SiftDown(size_t pos, const Entry& entry) {
+    const auto size = m_entries.size();
+    for (auto first = FirstChild(pos); first < size; first = FirstChild(pos)) {
+      const auto last = first + Arity < size ? first + Arity : size;
+      auto best = first;
+      for (auto i = first + 1; i < last; ++i) {
+        if (m_entries[i].m_value < m_entries[best].m_value)
+          best = i;
+      }
+      if (!(m_entries[best].m_value < entry.m_value))
+        break;
+      Place(pos, m_entries[best]);
+      pos = best;
+    }
+    Place(pos, entry);
+  }
+
+  std::vector<Entry, impl::SiblingAlignedAllocator<Entry>> m_entries;
+
+  // Position of each id in |m_entries|, or NOT_IN_HEAP.
+  std::vector<uint32_t> m_positions;
+};
+}  // namespace algo
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include "sequences/indexed_heap.h"
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+
+namespace algo {
+
+TEST(IndexedHeap, Smoke) {
+  IndexedHeap<int> heap(5);
+  ASSERT_TRUE(heap.Empty());
+  ASSERT_FALSE(heap.Contains(3));
+
+  heap.Push(3, 30);
+  heap.Push(1, 10);
+  heap.Push(4, 40);
+  ASSERT_EQ(3u, heap.Size());
+  ASSERT_TRUE(heap.Contains(3));
+  ASSERT_EQ(1u, heap.MinId());
+  ASSERT_EQ(10, heap.MinValue());
+
+  heap.DecreaseKey(4, 5);
+  ASSERT_EQ(4u, heap.MinId());
+  ASSERT_EQ(5, heap.Value(4));
+
+  heap.Erase(4);
+  ASSERT_FALSE(heap.Contains(4));
+  heap.Erase(4);
+  ASSERT_EQ(2u, heap.Size());
+
+  heap.IncreaseKey(1, 50);
+  ASSERT_EQ(3u, heap.MinId());
+  heap.Pop();
+  ASSERT_EQ(1u, heap.MinId());
+  ASSERT_EQ(50, heap.MinValue());
+  heap.Pop();
+  ASSERT_TRUE(heap.Empty());
+  ASSERT_FALSE(heap.Contains(1));
+}
+
+template <size_t Arity>
+void TestRandom() {
+  const uint32_t numIds = 100;
+  std::mt19937 engine(0 /* seed */);
+  IndexedHeap<uint64_t, Arity> heap(numIds);
+  // Values of ids in the heap, and the same entries ordered by value.
+  std::map<uint32_t, uint64_t> values;
+  std::map<std::pair<uint64_t, uint32_t>, bool> ordered;
+
+  for (int i = 0; i < 20000; ++i) {
+    const uint32_t id = engine() % numIds;
+    const uint64_t value = engine() % 1000;
+    const auto it = values.find(id);
+    switch (engine() % 4) {
+      case 0:
+      case 1:
+        if (it == values.end()) {
+          heap.Push(id, value);
+        } else {
+          ordered.erase({it->second, id});
+          if (value < it->second)
+            heap.DecreaseKey(id, value);
+          else
+            heap.IncreaseKey(id, value);
+        }
+        values[id] = value;
+        ordered[{value, id}] = true;
+        break;
+      case 2:
+        heap.Erase(id);
+        if (it != values.end()) {
+          ordered.erase({it->second, id});
+          values.erase(it);
+        }
+        break;
+      case 3:
+        if (!values.empty()) {
+          const auto [min, minId] = ordered.begin()->first;
+          ASSERT_EQ(min, heap.MinValue());
+          const auto popped = heap.MinId();
+          ASSERT_EQ(min, values[popped]);
+          heap.Pop();
+          ordered.erase({min, popped});
+          values.erase(popped);
+        }
+        break;
+    }
+
+    ASSERT_EQ(values.size(), heap.Size());
+    for (uint32_t id = 0; id < numIds; ++id) {
+      ASSERT_EQ(values.count(id) != 0, heap.Contains(id));
+      if (heap.Contains(id)) {
+        ASSERT_EQ(values[id], heap.Value(id));
+      }
+    }
+  }
+}
+
+TEST(IndexedHeap, Random) {
+  TestRandom<2>();
+  TestRandom<4>();
+  TestRandom<8>();
+}
+
+}  // namespace algo
@@ -1,10 +1,13 @@
 #pragma once
 
 #include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
-#include "sequences/heap.h"
+#include "sequences/dary_heap.h"
 
 namespace algo {
 // This is a wrapper around raw memory buffer. Used to hold start
@@ -18,32 +21,40 @@ struct Buffer {
   const size_t size_;
 };
 
+// Algorithm used to merge runs.
+enum class MergeEngine { Heap, LoserTree };
+
 // This class is used to pass options to an external memory merge-sort
 // algorithm.
 struct SortOptions {
   SortOptions()
       : cache_size_(6144 * 1024 /* L3 cache size for i7-4710MQ */),
-        cache_line_size_(64 /* cache line size for i7-4710MQ */) {}
+        cache_line_size_(64 /* cache line size for i7-4710MQ */),
+        engine_(MergeEngine::LoserTree) {}
 
-  SortOptions(size_t cache_size, size_t cache_line_size)
-      : cache_size_(cache_size), cache_line_size_(cache_line_size) {}
+  SortOptions(size_t cache_size, size_t cache_line_size, MergeEngine engine = MergeEngine::LoserTree)
+      : cache_size_(cache_size), cache_line_size_(cache_line_size), engine_(engine) {}
 
   const size_t cache_size_;
   const size_t cache_line_size_;
+  const MergeEngine engine_;
 };
 
-// Merges |num_buffers| buffers to out, returns a pointer to the end
-// of the sorted sequence.
+// Merges |num_buffers| buffers to out by a heap of buffer heads,
+// returns a pointer to the end of the sorted sequence.
 template <typename T>
-T* Merge(size_t num_buffers, Buffer<T> buffers[], T* out) {
+T* HeapMerge(size_t num_buffers, Buffer<T> buffers[], T* out) {
   using Value = std::pair<T /* elem */, size_t /* buffer */>;
-  Heap<Value> heap;
 
-  std::vector<size_t> offsets(num_buffers, 0);
+  std::vector<Value> heads;
   for (size_t i = 0; i < num_buffers; ++i) {
     if (buffers[i].size_ != 0)
-      heap.Push(std::make_pair(buffers[i].data_[0], i));
+      heads.emplace_back(buffers[i].data_[0], i);
   }
+  DaryHeap<Value> heap;
+  heap.Build(heads);
+
+  std::vector<size_t> offsets(num_buffers, 0);
 
   while (!heap.Empty()) {
     auto& elem = heap.Min();
@@ -66,6 +77,159 @@ T* Merge(size_t num_buffers, Buffer<T> buffers[], T* out) {
   return out;
 }
 
+namespace impl {
+// Nodes of the loser tree for integral types up to 32 bits: an
+// order-preserving unsigned image of an element in the high half and
+// the buffer in the low half, so a match is a comparison of 64-bit
+// integers. Exhausted buffers have the max node, which is greater
+// than any real one.
+template <typename T>
+struct PackedLoserTreeNodes {
+  using Node = uint64_t;
+  using Key = std::make_unsigned_t<T>;
+
+  static constexpr Key SIGN_FLIP = std::is_signed_v<T> ? static_cast<Key>(1) << (8 * sizeof(T) - 1) : 0;
+
+  PackedLoserTreeNodes(size_t /* num_buffers */, const Buffer<T>* /* buffers */) {}
+
+  static Node Make(const T& elem, uint32_t buffer) {
+    return (static_cast<uint64_t>(static_cast<Key>(elem) ^ SIGN_FLIP) << 32) | buffer;
+  }
+  static Node Sentinel() { return UINT64_MAX; }
+
+  static T Elem(Node node) { return static_cast<T>(static_cast<Key>(node >> 32) ^ SIGN_FLIP); }
+  static uint32_t Buffer(Node node) { return static_cast<uint32_t>(node); }
+
+  // Replays a match: the loser stays at the node, the winner goes up.
+  // Nodes are swapped by a mask, as compilers tend to turn min() and
+  // max() into a branch here.
+  static void Play(Node& loser, Node& winner) {
+    const Node swap = (loser ^ winner) & -static_cast<Node>(loser < winner);
+    loser ^= swap;
+    winner ^= swap;
+  }
+};
+
+// Nodes of the loser tree for other types: an element and its
+// buffer. The sentinel for exhausted buffers holds the max element of
+// all buffers and loses all ties, so a match is a single comparison
+// of elements.
+template <typename T>
+struct GenericLoserTreeNodes {
+  static constexpr uint32_t DONE = UINT32_MAX;
+
+  struct Node {
+    T elem_;
+    uint32_t buffer_;
+  };
+
+  // There must be at least one element in |buffers|.
+  GenericLoserTreeNodes(size_t num_buffers, const Buffer<T> buffers[]) {
+    for (size_t i = 0; i < num_buffers; ++i) {
+      if (buffers[i].size_ == 0)
+        continue;
+      const T* last = buffers[i].data_ + buffers[i].size_ - 1;
+      if (max_ == nullptr || *max_ < *last)
+        max_ = last;
+    }
+  }
+
+  static Node Make(const T& elem, uint32_t buffer) { return Node{elem, buffer}; }
+  Node Sentinel() const { return Node{*max_, DONE}; }
+
+  static const T& Elem(const Node& node) { return node.elem_; }
+  static uint32_t Buffer(const Node& node) { return node.buffer_; }
+
+  // Both nodes are always written, indexed by the result of the
+  // match, so that the compiler does not turn this into a branch. A
+  // sentinel loser never beats the winner, as it holds the max
+  // element.
+  static void Play(Node& loser, Node& winner) {
+    const Node match[2] = {winner, loser};
+    const size_t swap = (match[0].buffer_ == DONE) | (match[1].elem_ < match[0].elem_);
+    loser = match[1 - swap];
+    winner = match[swap];
+  }
+
+  const T* max_ = nullptr;
+};
+
+template <typename T>
+using LoserTreeNodes = std::conditional_t<std::is_integral_v<T> && sizeof(T) <= 4,
+                                          PackedLoserTreeNodes<T>,
+                                          GenericLoserTreeNodes<T>>;
+}  // namespace impl
+
+// Merges |num_buffers| buffers to out by a tournament tree of losers,
+// returns a pointer to the end of the sorted sequence.
+//
+// Each inner node keeps the loser of the match between its subtrees,
+// together with its buffer, and the overall winner is kept aside. An
+// output element is replaced by the next one from the same buffer,
+// which replays matches on the path to the root only: exactly log k
+// comparisons, and no comparisons between siblings as in a heap.
+// Matches are branch-free, as their outcomes are unpredictable, and
+// exhausted buffers are replaced by sentinels that lose every match
+// with a real element.
+template <typename T>
+T* LoserTreeMerge(size_t num_buffers, Buffer<T> buffers[], T* out) {
+  using Nodes = impl::LoserTreeNodes<T>;
+  using Node = typename Nodes::Node;
+
+  size_t total = 0;
+  for (size_t i = 0; i < num_buffers; ++i)
+    total += buffers[i].size_;
+  if (total == 0)
+    return out;
+
+  const Nodes nodes(num_buffers, buffers);
+
+  // Leaves are [num_leaves, 2 * num_leaves), inner nodes are [1,
+  // num_leaves).
+  const size_t num_leaves = std::bit_ceil(num_buffers);
+  std::vector<Node> winners(2 * num_leaves, nodes.Sentinel());
+  for (size_t i = 0; i < num_buffers; ++i) {
+    if (buffers[i].size_ != 0)
+      winners[num_leaves + i] = Nodes::Make(buffers[i].data_[0], static_cast<uint32_t>(i));
+  }
+
+  std::vector<Node> losers(num_leaves, nodes.Sentinel());
+  for (size_t node = num_leaves - 1; node != 0; --node) {
+    losers[node] = winners[2 * node];
+    winners[node] = winners[2 * node + 1];
+    Nodes::Play(losers[node], winners[node]);
+  }
+
+  std::vector<const T*> next(num_buffers);
+  std::vector<const T*> ends(num_buffers);
+  for (size_t i = 0; i < num_buffers; ++i) {
+    next[i] = buffers[i].data_ + std::min(buffers[i].size_, static_cast<size_t>(1));
+    ends[i] = buffers[i].data_ + buffers[i].size_;
+  }
+
+  Node winner = winners[1];
+  for (T* const end = out + total; out != end;) {
+    *out++ = Nodes::Elem(winner);
+
+    // Sentinels lose all matches with real elements, so the winner
+    // here is always real.
+    const auto buffer = Nodes::Buffer(winner);
+    winner = next[buffer] != ends[buffer] ? Nodes::Make(*next[buffer]++, buffer) : nodes.Sentinel();
+    for (size_t node = (num_leaves + buffer) / 2; node != 0; node /= 2)
+      Nodes::Play(losers[node], winner);
+  }
+  return out;
+}
+
+// Merges |num_buffers| buffers to out by the |engine|, returns a
+// pointer to the end of the sorted sequence.
+template <typename T>
+T* Merge(size_t num_buffers, Buffer<T> buffers[], T* out, MergeEngine engine = MergeEngine::LoserTree) {
+  if (engine == MergeEngine::Heap)
+    return HeapMerge(num_buffers, buffers, out);
+  return LoserTreeMerge(num_buffers, buffers, out);
+}
+
 // An external-memory merge-sort algorithm. Not quite efficient and
 // can be beat by std::sort() or even std::stable_sort() algorithms.
 template <typename T>
@@ -103,7 +267,7 @@ void MergeSort(size_t n, T* data, const SortOptions& options = SortOptions()) {
     T* start = nxtData;
     while (i < curRuns.size()) {
       const size_t num_runs = std::min(runs_to_merge, curRuns.size() - i);
-      T* end = Merge(num_runs, &curRuns[i], start);
+      T* end = Merge(num_runs, &curRuns[i], start, options.engine_);
 
       nxtRuns.emplace_back(start, end - start);
       start = end;
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
 #include <vector>
 
 #include "sequences/merge_sort.h"
@@ -20,3 +24,107 @@ TEST(Merge, Sort) {
 
   ASSERT_EQ(data, expected);
 }
+
+template <typename T, typename Gen>
+void TestMergeEngines(Gen&& gen) {
+  std::mt19937 engine(0 /* seed */);
+  for (size_t num_buffers = 1; num_buffers <= 17; ++num_buffers) {
+    std::vector<std::vector<T>> runs(num_buffers);
+    std::vector<T> expected;
+    for (auto& run : runs) {
+      run.resize(engine() % 20);
+      for (auto& elem : run)
+        elem = gen(engine);
+      std::sort(run.begin(), run.end());
+      expected.insert(expected.end(), run.begin(), run.end());
+    }
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<algo::Buffer<T>> buffers;
+    for (auto& run : runs)
+      buffers.emplace_back(run.data(), run.size());
+
+    for (const auto merge_engine : {algo::MergeEngine::Heap, algo::MergeEngine::LoserTree}) {
+      std::vector<T> merged(expected.size());
+      T* end = algo::Merge(buffers.size(), buffers.data(), merged.data(), merge_engine);
+      ASSERT_EQ(merged.data() + merged.size(), end);
+      ASSERT_EQ(expected, merged);
+    }
+  }
+}
+
+TEST(Merge, Engines) {
+  // Max values are the same as sentinels in the loser tree.
+  TestMergeEngines<int>([](std::mt19937& engine) {
+    return engine() % 4 == 0 ? std::numeric_limits<int>::max() : static_cast<int>(engine() % 100) - 50;
+  });
+  TestMergeEngines<double>([](std::mt19937& engine) { return static_cast<double>(engine() % 100) / 4; });
+  TestMergeEngines<std::string>([](std::mt19937& engine) { return std::string(engine() % 4, 'a' + engine() % 3); });
+}
+
+namespace {
+// Records are ordered by keys only, and have no default constructor.
+struct Rec {
+  Rec(int key, int id) : key_(key), id_(id) {}
+
+  bool operator<(const Rec& rhs) const { return key_ < rhs.key_; }
+  bool operator<=(const Rec& rhs) const { return key_ <= rhs.key_; }
+
+  int key_;
+  int id_;
+};
+}  // namespace
+
+TEST(Merge, EnginesEqualKeys) {
+  std::vector<std::vector<Rec>> runs = {{{1, 0}, {5, 1}}, {{2, 2}, {5, 3}}, {{5, 4}}};
+  std::mt19937 engine(0 /* seed */);
+  for (size_t num_buffers = 1; num_buffers <= 9; ++num_buffers) {
+    std::vector<Rec> run;
+    const size_t size = engine() % 8;
+    for (size_t i = 0; i < size; ++i)
+      run.emplace_back(static_cast<int>(engine() % 4), static_cast<int>(100 * num_buffers + i));
+    std::sort(run.begin(), run.end());
+    runs.push_back(run);
+  }
+
+  std::vector<algo::Buffer<Rec>> buffers;
+  for (auto& run : runs)
+    buffers.emplace_back(run.data(), run.size());
+
+  for (const auto merge_engine : {algo::MergeEngine::Heap, algo::MergeEngine::LoserTree}) {
+    for (size_t num_buffers = 1; num_buffers <= buffers.size(); ++num_buffers) {
+      std::vector<int> ids;
+      for (size_t i = 0; i < num_buffers; ++i) {
+        for (const auto& rec : runs[i])
+          ids.push_back(rec.id_);
+      }
+      std::sort(ids.begin(), ids.end());
+
+      std::vector<Rec> merged(ids.size(), Rec(0, 0));
+      algo::Merge(num_buffers, buffers.data(), merged.data(), merge_engine);
+      ASSERT_TRUE(std::is_sorted(merged.begin(), merged.end()));
+
+      std::vector<int> merged_ids;
+      for (const auto& rec : merged)
+        merged_ids.push_back(rec.id_);
+      std::sort(merged_ids.begin(), merged_ids.end());
+      ASSERT_EQ(ids, merged_ids);
+    }
+  }
+}
+
+TEST(Merge, SortEngines) {
+  std::mt19937 engine(0 /* seed */);
+  std::vector<uint32_t> data(10000);
+  for (auto& elem : data)
+    elem = engine();
+  std::vector<uint32_t> expected(data.begin(), data.end());
+  std::sort(expected.begin(), expected.end());
+
+  for (const auto merge_engine : {algo::MergeEngine::Heap, algo::MergeEngine::LoserTree}) {
+    std::vector<uint32_t> sorted(data.begin(), data.end());
+    algo::MergeSort(sorted.size(), sorted.data(),
+                    algo::SortOptions(256 /* cache_size */, 16 /* cache_line_size */, merge_engine));
+    ASSERT_EQ(expected, sorted);
+  }
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "sequences/dary_heap.h"
+
+namespace algo {
+// Relaxed concurrent min-priority queue, all methods may be called
+// concurrently. It's a set of independent heaps, each behind its own
+// lock, usually c * P of them for P threads. Push() goes to a random
+// heap, and Pop() looks at |numChoices| random heaps and pops the
+// best min among them. Locks are only tried, and a busy heap is
+// replaced by another random one, so threads rarely wait for each
+// other.
+//
+// Pops are not exact: a popped element is among the smallest ones
+// with high probability, and the expected rank error grows with the
+// number of heaps and drops with the number of choices. Thus more
+// heaps and fewer choices give more throughput, and vice versa.
+//
+// See H. Rihani, P. Sanders, R. Dementiev, "MultiQueues: Simpler,
+// Faster, and Better Relaxed Concurrent Priority Queues".
+template <typename T>
+class MultiQueue {
+public:
+  MultiQueue(size_t numQueues, size_t numChoices = 2) : m_queues(numQueues), m_numChoices(numChoices) {
+    assert(numQueues != 0);
+    assert(numChoices != 0);
+  }
+
+  void Push(const T& value) {
+    while (true) {
+      auto& queue = m_queues[Random() % m_queues.size()];
+      std::unique_lock lock(queue.m_mutex, std::try_to_lock);
+      if (!lock.owns_lock())
+        continue;
+      queue.m_heap.Push(value);
+      return;
+    }
+  }
+
+  // Pops an element close to the min. Returns nothing iff all heaps
+  // were seen empty.
+  std::optional<T> Pop() {
+    // Random attempts that found only empty heaps, after which heaps
+    // are scanned to tell whether the whole queue is empty. Attempts
+    // that hit busy heaps are just retried, so that contention does
+    // not lead to the blocking scan.
+    size_t numEmpty = 0;
+    while (numEmpty < m_queues.size()) {
+      Queue* best = nullptr;
+      std::unique_lock<std::mutex> bestLock;
+      bool allEmpty = true;
+      for (size_t i = 0; i < m_numChoices; ++i) {
+        auto& queue = m_queues[Random() % m_queues.size()];
+        if (&queue == best)
+          continue;
+        std::unique_lock lock(queue.m_mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+          allEmpty = false;
+          continue;
+        }
+        if (queue.m_heap.Empty())
+          continue;
+        if (best == nullptr || queue.m_heap.Min() < best->m_heap.Min()) {
+          best = &queue;
+          bestLock = std::move(lock);
+        }
+      }
+
+      if (best != nullptr)
+        return PopLocked(*best);
+      if (allEmpty)
+        ++numEmpty;
+    }
+
+    for (auto& queue : m_queues) {
+      std::lock_guard lock(queue.m_mutex);
+      if (!queue.m_heap.Empty())
+        return PopLocked(queue);
+    }
+    return {};
+  }
+
+  size_t NumQueues() const { return m_queues.size(); }
+
+private:
+  struct alignas(64) Queue {
+    std::mutex m_mutex;
+    DaryHeap<T> m_heap;
+  };
+
+  static std::optional<T> PopLocked(Queue& queue) {
+    T value = std::move(queue.m_heap.Min());
+    queue.m_heap.Pop();
+    return value;
+  }
+
+  // Returns a pseudo-random number from a per-thread xorshift
+  // generator.
+  static uint64_t Random() {
+    thread_local uint64_t state = std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+
+  std::vector<Queue> m_queues;
+  const size_t m_numChoices;
+};
+}  // namespace algo
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include "sequences/multi_queue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace algo {
+
+TEST(MultiQueue, Smoke) {
+  MultiQueue<int> queue(4 /* numQueues */);
+  ASSERT_FALSE(queue.Pop());
+
+  for (int i = 0; i < 100; ++i)
+    queue.Push(i);
+
+  std::vector<int> popped;
+  while (const auto value = queue.Pop())
+    popped.push_back(*value);
+  std::sort(popped.begin(), popped.end());
+  ASSERT_EQ(100u, popped.size());
+  for (int i = 0; i < 100; ++i)
+    ASSERT_EQ(i, popped[i]);
+}
+
+TEST(MultiQueue, SingleQueueIsExact) {
+  MultiQueue<int> queue(1 /* numQueues */);
+  for (int value : {5, 3, 8, 1, 9, 2})
+    queue.Push(value);
+  for (int expected : {1, 2, 3, 5, 8, 9})
+    ASSERT_EQ(expected, queue.Pop());
+  ASSERT_FALSE(queue.Pop());
+}
+
+TEST(MultiQueue, Concurrent) {
+  const unsigned numThreads = 4;
+  const uint32_t numValues = 10000;
+  MultiQueue<uint32_t> queue(2 * numThreads);
+
+  std::atomic<uint64_t> pushed{0};
+  std::atomic<uint64_t> popped{0};
+  std::atomic<uint32_t> numPopped{0};
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < numThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (uint32_t i = t; i < numValues; i += numThreads) {
+        queue.Push(i);
+        pushed += i;
+        if (i % 2 == 0) {
+          if (const auto value = queue.Pop()) {
+            popped += *value;
+            ++numPopped;
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  while (const auto value = queue.Pop()) {
+    popped += *value;
+    ++numPopped;
+  }
+  ASSERT_EQ(numValues, numPopped.load());
+  ASSERT_EQ(pushed.load(), popped.load());
+}
+
+}  // namespace algo
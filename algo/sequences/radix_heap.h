@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace algo {
+// Monotone priority queue over 64-bit keys: a pushed key must not be
+// less than the key of the last Min(). This holds for event
+// simulations and for Dijkstra with non-negative weights, and allows
+// to avoid comparisons between items.
+//
+// An item goes to the bucket numbered by the highest bit in which its
+// key differs from the last min, so bucket 0 holds items equal to the
+// last min. When bucket 0 is empty, the first non-empty bucket is
+// redistributed around its min, and each item moves to a lower bucket.
+// Thus each item is moved at most 64 times, and in practice only a few
+// times, as most items are close to the min.
+template <typename T>
+class RadixHeap {
+public:
+  using Item = std::pair<uint64_t /* key */, T /* value */>;
+
+  // Complexity: O(1).
+  void Push(const Item& item) {
+    assert(item.first >= m_last);
+    m_buckets[BucketIndex(item.first)].push_back(item);
+    ++m_size;
+  }
+
+  // Returns an item with the min key. It's not const, as buckets are
+  // redistributed lazily.
+  // Complexity: O(log C) amortized, where C is the max difference
+  // between keys.
+  const Item& Min() {
+    assert(!Empty());
+    if (m_buckets[0].empty())
+      Redistribute();
+    return m_buckets[0].back();
+  }
+
+  void Pop() {
+    Min();
+    m_buckets[0].pop_back();
+    --m_size;
+  }
+
+  size_t Size() const { return m_size; }
+  bool Empty() const { return m_size == 0; }
+
+private:
+  size_t BucketIndex(uint64_t key) const { return std::bit_width(key ^ m_last); }
+
+  void Redistribute() {
+    size_t i = 1;
+    while (m_buckets[i].empty())
+      ++i;
+
+    auto& bucket = m_buckets[i];
+    m_last = bucket[0].first;
+    for (const auto& item : bucket) {
+      if (item.first < m_last)
+        m_last = item.first;
+    }
+    for (const auto& item : bucket)
+      m_buckets[BucketIndex(item.first)].push_back(item);
+    bucket.clear();
+  }
+
+  std::array<std::vector<Item>, 65> m_buckets;
+  uint64_t m_last = 0;
+  size_t m_size = 0;
+};
+}  // namespace algo
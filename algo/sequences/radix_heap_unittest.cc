@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include "sequences/radix_heap.h"
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace algo {
+
+TEST(RadixHeap, Smoke) {
+  RadixHeap<int> heap;
+  ASSERT_TRUE(heap.Empty());
+
+  heap.Push({5, 50});
+  heap.Push({3, 30});
+  heap.Push({1000000000000, 1});
+  heap.Push({3, 31});
+  ASSERT_EQ(4u, heap.Size());
+
+  ASSERT_EQ(3u, heap.Min().first);
+  heap.Pop();
+  ASSERT_EQ(3u, heap.Min().first);
+  heap.Pop();
+
+  heap.Push({4, 40});
+  ASSERT_EQ(4u, heap.Min().first);
+  ASSERT_EQ(40, heap.Min().second);
+  heap.Pop();
+  ASSERT_EQ(5u, heap.Min().first);
+  heap.Pop();
+  ASSERT_EQ(1000000000000u, heap.Min().first);
+  heap.Pop();
+  ASSERT_TRUE(heap.Empty());
+}
+
+TEST(RadixHeap, Random) {
+  std::mt19937_64 engine(0 /* seed */);
+  for (const uint64_t maxDelta : {1, 10, 1000, 1 << 30}) {
+    RadixHeap<uint32_t> heap;
+    std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>> expected;
+    uint64_t last = 0;
+    for (uint32_t i = 0; i < 10000; ++i) {
+      if (engine() % 3 != 0 || expected.empty()) {
+        const uint64_t key = last + engine() % maxDelta;
+        heap.Push({key, i});
+        expected.push(key);
+      } else {
+        last = heap.Min().first;
+        ASSERT_EQ(expected.top(), last);
+        heap.Pop();
+        expected.pop();
+      }
+      ASSERT_EQ(expected.size(), heap.Size());
+    }
+  }
+}
+
+}  // namespace algo
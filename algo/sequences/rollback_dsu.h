@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace algo {
+// DSU whose unions can be undone in LIFO order. Nodes are packed the
+// same way as in CompactDSU, but there is no path compression, so
+// each union changes exactly two entries, which are recorded on a
+// stack. Union by size keeps height logarithmic.
+class RollbackDSU {
+public:
+  explicit RollbackDSU(uint32_t n) : m_nodes(n, -1), m_numComponents(n) { assert(n <= INT32_MAX); }
+
+  // Complexity: O(log n).
+  uint32_t GetParent(uint32_t u) const {
+    while (m_nodes[u] >= 0)
+      u = m_nodes[u];
+    return u;
+  }
+
+  // Complexity: O(log n).
+  bool Union(uint32_t u, uint32_t v) {
+    u = GetParent(u);
+    v = GetParent(v);
+    if (u == v)
+      return false;
+
+    if (m_nodes[u] > m_nodes[v])
+      std::swap(u, v);
+    m_changes.push_back(Change{v, m_nodes[v]});
+    m_nodes[u] += m_nodes[v];
+    m_nodes[v] = u;
+
+    --m_numComponents;
+
+    return true;
+  }
+
+  // Returns a handle to the current state, for Rollback().
+  size_t Snapshot() const { return m_changes.size(); }
+
+  // Undoes all unions done after |snapshot| was taken. Snapshots
+  // taken after |snapshot| become invalid.
+  // Complexity: O(number of undone unions).
+  void Rollback(size_t snapshot) {
+    assert(snapshot <= m_changes.size());
+    while (m_changes.size() > snapshot) {
+      const auto [child, size] = m_changes.back();
+      m_changes.pop_back();
+      m_nodes[m_nodes[child]] -= size;
+      m_nodes[child] = size;
+      ++m_numComponents;
+    }
+  }
+
+  // Returns size of the component of |u|.
+  uint32_t Size(uint32_t u) const { return -m_nodes[GetParent(u)]; }
+
+  uint32_t NumComponents() const { return m_numComponents; }
+
+private:
+  struct Change {
+    // Root that was linked under another root.
+    uint32_t m_child{};
+
+    // Minus size of the component of |m_child| before the union.
+    int32_t m_size{};
+  };
+
+  std::vector<int32_t> m_nodes;
+  std::vector<Change> m_changes;
+  uint32_t m_numComponents{};
+};
+}  // namespace algo
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include "sequences/compact_dsu.h"
+#include "sequences/rollback_dsu.h"
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace algo;
+
+namespace {
+TEST(RollbackDSU, Small) {
+  RollbackDSU dsu{5};
+  const auto empty = dsu.Snapshot();
+
+  ASSERT_TRUE(dsu.Union(0, 1));
+  ASSERT_FALSE(dsu.Union(1, 0));
+  const auto snapshot = dsu.Snapshot();
+
+  ASSERT_TRUE(dsu.Union(1, 2));
+  ASSERT_TRUE(dsu.Union(3, 4));
+  ASSERT_EQ(3u, dsu.Size(0));
+  ASSERT_EQ(2u, dsu.NumComponents());
+
+  dsu.Rollback(snapshot);
+  ASSERT_EQ(dsu.GetParent(0), dsu.GetParent(1));
+  ASSERT_NE(dsu.GetParent(1), dsu.GetParent(2));
+  ASSERT_NE(dsu.GetParent(3), dsu.GetParent(4));
+  ASSERT_EQ(2u, dsu.Size(1));
+  ASSERT_EQ(4u, dsu.NumComponents());
+
+  dsu.Rollback(empty);
+  ASSERT_EQ(5u, dsu.NumComponents());
+  for (uint32_t i = 0; i < 5; ++i)
+    ASSERT_EQ(i, dsu.GetParent(i));
+}
+
+TEST(RollbackDSU, Random) {
+  const uint32_t n = 200;
+  std::mt19937 engine(0 /* seed */);
+  RollbackDSU dsu{n};
+
+  // Stack of applied unions, replayed on a CompactDSU after each
+  // rollback.
+  std::vector<std::pair<uint32_t, uint32_t>> unions;
+  std::vector<std::pair<size_t, size_t>> snapshots;
+  for (int i = 0; i < 3000; ++i) {
+    if (engine() % 4 == 0 && !snapshots.empty()) {
+      const auto [snapshot, numUnions] = snapshots.back();
+      snapshots.pop_back();
+      dsu.Rollback(snapshot);
+      unions.resize(numUnions);
+    } else {
+      if (engine() % 3 == 0)
+        snapshots.emplace_back(dsu.Snapshot(), unions.size());
+      const uint32_t u = engine() % n;
+      const uint32_t v = engine() % n;
+      dsu.Union(u, v);
+      unions.emplace_back(u, v);
+    }
+
+    CompactDSU expected{n};
+    for (const auto& [u, v] : unions)
+      expected.Union(u, v);
+    ASSERT_EQ(expected.NumComponents(), dsu.NumComponents());
+    for (uint32_t u = 0; u < n; ++u) {
+      ASSERT_EQ(expected.GetParent(u) == expected.GetParent(0), dsu.GetParent(u) == dsu.GetParent(0));
+      ASSERT_EQ(expected.Size(u), dsu.Size(u));
+    }
+  }
+}
+}  // namespace
@@ -0,0 +1,232 @@
+#include "sequences/wavelet_matrix.h"
+
+#include "bits/bits.h"
+
+#include <algorithm>
+#include <barrier>
+#include <utility>
+
+namespace algo {
+namespace {
+// Calls |fn(i)| for all 0 <= i < n, each call on its own thread.
+template <typename Fn>
+void ParallelFor(uint64_t n, Fn&& fn) {
+  std::vector<std::thread> threads;
+  for (uint64_t i = 1; i < n; ++i)
+    threads.emplace_back(fn, i);
+  if (n != 0)
+    fn(0);
+  for (auto& thread : threads)
+    thread.join();
+}
+}  // namespace
+
+WaveletMatrix::WaveletMatrix(std::span<const uint64_t> values, unsigned numThreads) : m_size{values.size()} {
+  numThreads = std::max(numThreads, 1u);
+
+  const uint64_t maxValue = values.empty() ? 0 : *std::max_element(values.begin(), values.end());
+  const uint64_t numLevels = HiPos(maxValue) + 1;
+
+  // Values are split on chunks of whole blocks, so threads never
+  // write to the same block of a level.
+  const uint64_t numBlocks = (m_size + 63) / 64;
+  const uint64_t chunkSize = 64 * std::max<uint64_t>((numBlocks + numThreads - 1) / numThreads, 1);
+  const uint64_t numChunks = (m_size + chunkSize - 1) / chunkSize;
+
+  std::vector<uint64_t> curr(values.begin(), values.end());
+  std::vector<uint64_t> next(m_size);
+  std::vector<uint64_t> zeros(numChunks);
+  std::vector<uint64_t> ones(numChunks);
+
+  m_levels.reserve(numLevels);
+  for (uint64_t level = 0; level < numLevels; ++level)
+    m_levels.emplace_back(m_size);
+  m_numZeros.assign(numLevels, 0);
+
+  // Each chunk has a single thread for all levels. Threads meet twice
+  // per level: after counting zeroes and ones of their chunks, when
+  // counts are turned into starting positions of zeroes and ones of
+  // each chunk in the next level, and after moving values there.
+  uint64_t level = 0;
+  std::barrier counted(numChunks, [&]() noexcept {
+    uint64_t numZeros = 0;
+    for (const auto z : zeros)
+      numZeros += z;
+    uint64_t zerosBefore = 0;
+    uint64_t onesBefore = numZeros;
+    for (uint64_t chunk = 0; chunk < numChunks; ++chunk) {
+      zerosBefore += std::exchange(zeros[chunk], zerosBefore);
+      onesBefore += std::exchange(ones[chunk], onesBefore);
+    }
+    m_numZeros[level] = numZeros;
+  });
+  std::barrier moved(numChunks, [&]() noexcept {
+    curr.swap(next);
+    ++level;
+  });
+
+  ParallelFor(numChunks, [&](uint64_t chunk) {
+    const uint64_t from = chunk * chunkSize;
+    const uint64_t to = std::min(from + chunkSize, m_size);
+    for (uint64_t l = 0; l < numLevels; ++l) {
+      const uint64_t shift = numLevels - 1 - l;
+      auto& bits = m_levels[l];
+
+      uint64_t numOnes = 0;
+      for (uint64_t i = from; i < to; ++i) {
+        if ((curr[i] >> shift) & 1) {
+          bits.Set(i);
+          ++numOnes;
+        }
+      }
+      zeros[chunk] = to - from - numOnes;
+      ones[chunk] = numOnes;
+      counted.arrive_and_wait();
+
+      uint64_t z = zeros[chunk];
+      uint64_t o = ones[chunk];
+      for (uint64_t i = from; i < to; ++i) {
+        if ((curr[i] >> shift) & 1)
+          next[o++] = curr[i];
+        else
+          next[z++] = curr[i];
+      }
+      moved.arrive_and_wait();
+    }
+  });
+
+  // Rank tables are independent, so levels are distributed among at
+  // most |numThreads| threads.
+  std::vector<std::optional<RSTable>> ranks(numLevels);
+  const uint64_t numWorkers = std::min<uint64_t>(numThreads, numLevels);
+  ParallelFor(numWorkers, [&](uint64_t worker) {
+    for (uint64_t l = worker; l < numLevels; l += numWorkers)
+      ranks[l].emplace(m_levels[l]);
+  });
+  for (auto& rank : ranks)
+    m_ranks.push_back(std::move(*rank));
+}
+
+uint64_t WaveletMatrix::Access(uint64_t i) const {
+  assert(i < m_size);
+  uint64_t value = 0;
+  for (uint64_t level = 0; level < NumLevels(); ++level) {
+    const auto& ranks = m_ranks[level];
+    if (ranks.Test(i)) {
+      value = (value << 1) | 1;
+      i = m_numZeros[level] + ranks.Rank1(i);
+    } else {
+      value = value << 1;
+      i = ranks.Rank0(i);
+    }
+  }
+  return value;
+}
+
+uint64_t WaveletMatrix::Rank(uint64_t c, uint64_t i) const {
+  assert(i <= m_size);
+  if (!InAlphabet(c))
+    return 0;
+
+  // [from, to) is a range of values having the same prefix as |c| on
+  // the current level.
+  uint64_t from = 0;
+  uint64_t to = i;
+  for (uint64_t level = 0; level < NumLevels(); ++level) {
+    const auto& ranks = m_ranks[level];
+    if (Bit(c, level)) {
+      from = m_numZeros[level] + ranks.Rank1(from);
+      to = m_numZeros[level] + ranks.Rank1(to);
+    } else {
+      from = ranks.Rank0(from);
+      to = ranks.Rank0(to);
+    }
+  }
+  return to - from;
+}
+
+std::optional<uint64_t> WaveletMatrix::Select(uint64_t c, uint64_t k) const {
+  if (!InAlphabet(c))
+    return {};
+
+  uint64_t from = 0;
+  uint64_t to = m_size;
+  for (uint64_t level = 0; level < NumLevels(); ++level) {
+    const auto& ranks = m_ranks[level];
+    if (Bit(c, level)) {
+      from = m_numZeros[level] + ranks.Rank1(from);
+      to = m_numZeros[level] + ranks.Rank1(to);
+    } else {
+      from = ranks.Rank0(from);
+      to = ranks.Rank0(to);
+    }
+  }
+  if (to - from <= k)
+    return {};
+
+  // Goes back from the position of the occurrence after the last
+  // level to its original position.
+  uint64_t pos = from + k;
+  for (uint64_t level = NumLevels(); level-- > 0;) {
+    const auto& ranks = m_ranks[level];
+    if (Bit(c, level))
+      pos = ranks.Select1(pos - m_numZeros[level]);
+    else
+      pos = ranks.Select0(pos);
+  }
+  return pos;
+}
+
+uint64_t WaveletMatrix::Quantile(uint64_t from, uint64_t to, uint64_t k) const {
+  assert(from <= to);
+  assert(to <= m_size);
+  assert(k < to - from);
+
+  uint64_t value = 0;
+  for (uint64_t level = 0; level < NumLevels(); ++level) {
+    const auto& ranks = m_ranks[level];
+    const uint64_t zerosFrom = ranks.Rank0(from);
+    const uint64_t zerosTo = ranks.Rank0(to);
+    if (k < zerosTo - zerosFrom) {
+      value = value << 1;
+      from = zerosFrom;
+      to = zerosTo;
+    } else {
+      value = (value << 1) | 1;
+      k -= zerosTo - zerosFrom;
+      from = m_numZeros[level] + (from - zerosFrom);
+      to = m_numZeros[level] + (to - zerosTo);
+    }
+  }
+  return value;
+}
+
+uint64_t WaveletMatrix::RangeFreq(uint64_t from, uint64_t to, uint64_t lo, uint64_t hi) const {
+  assert(from <= to);
+  assert(to <= m_size);
+  if (lo >= hi)
+    return 0;
+  return CountLess(from, to, hi) - CountLess(from, to, lo);
+}
+
+uint64_t WaveletMatrix::CountLess(uint64_t from, uint64_t to, uint64_t c) const {
+  if (!InAlphabet(c))
+    return to - from;
+
+  uint64_t count = 0;
+  for (uint64_t level = 0; level < NumLevels(); ++level) {
+    const auto& ranks = m_ranks[level];
+    const uint64_t zerosFrom = ranks.Rank0(from);
+    const uint64_t zerosTo = ranks.Rank0(to);
+    if (Bit(c, level)) {
+      count += zerosTo - zerosFrom;
+      from = m_numZeros[level] + (from - zerosFrom);
+      to = m_numZeros[level] + (to - zerosTo);
+    } else {
+      from = zerosFrom;
+      to = zerosTo;
+    }
+  }
+  return count;
+}
+}  // namespace algo
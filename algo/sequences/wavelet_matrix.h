@@ -0,0 +1,67 @@
+#pragma once
+
+#include "bits/bit_vector.h"
+#include "bits/rs_table.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace algo {
+// Wavelet matrix over a sequence of integers. Level l holds the
+// (NumLevels() - 1 - l)-th bits of values, reordered so that values
+// with zero on the previous level go first, in a stable way. Each
+// level is a BitVector with an RSTable, so all queries below take
+// O(NumLevels()) rank or select calls.
+//
+// See F. Claude, G. Navarro, A. Ordóñez, "The wavelet matrix".
+class WaveletMatrix {
+public:
+  // Builds wavelet matrix of |values|. Levels depend on each other,
+  // so each level is built by up to |numThreads| threads working on
+  // disjoint ranges of values. Rank tables of all levels are built in
+  // parallel at the end, by up to |numThreads| threads as well.
+  explicit WaveletMatrix(std::span<const uint64_t> values, unsigned numThreads = std::thread::hardware_concurrency());
+
+  // Returns |i|-th value.
+  uint64_t Access(uint64_t i) const;
+
+  // Returns number of occurrences of |c| among the first |i| values.
+  uint64_t Rank(uint64_t c, uint64_t i) const;
+
+  // Returns position of |k|-th (0-based) occurrence of |c|, if any.
+  std::optional<uint64_t> Select(uint64_t c, uint64_t k) const;
+
+  // Returns |k|-th (0-based) smallest value in the range [|from|,
+  // |to|). |k| should be less than |to| - |from|.
+  uint64_t Quantile(uint64_t from, uint64_t to, uint64_t k) const;
+
+  // Returns number of values in the range [|from|, |to|) that are
+  // not less than |lo| and less than |hi|.
+  uint64_t RangeFreq(uint64_t from, uint64_t to, uint64_t lo, uint64_t hi) const;
+
+  uint64_t Size() const { return m_size; }
+  uint64_t NumLevels() const { return m_levels.size(); }
+
+private:
+  // Returns number of values less than |c| in the range [|from|,
+  // |to|).
+  uint64_t CountLess(uint64_t from, uint64_t to, uint64_t c) const;
+
+  bool InAlphabet(uint64_t c) const { return NumLevels() == 64 || (c >> NumLevels()) == 0; }
+
+  uint64_t Bit(uint64_t c, uint64_t level) const { return (c >> (NumLevels() - 1 - level)) & 1; }
+
+  uint64_t m_size{};
+
+  std::vector<BitVector> m_levels;
+  std::vector<RSTable> m_ranks;
+
+  // Number of zeroes on each level.
+  std::vector<uint64_t> m_numZeros;
+};
+}  // namespace algo
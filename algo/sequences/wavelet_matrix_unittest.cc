@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "sequences/wavelet_matrix.h"
+
+namespace {
+void TestWaveletMatrix(const std::vector<uint64_t>& values, unsigned numThreads) {
+  const algo::WaveletMatrix wm(values, numThreads);
+  ASSERT_EQ(values.size(), wm.Size());
+
+  const uint64_t maxValue = values.empty() ? 0 : *std::max_element(values.begin(), values.end());
+
+  for (size_t i = 0; i < values.size(); ++i)
+    ASSERT_EQ(values[i], wm.Access(i));
+
+  for (uint64_t c = 0; c <= maxValue + 1; ++c) {
+    uint64_t count = 0;
+    for (size_t i = 0; i <= values.size(); ++i) {
+      ASSERT_EQ(count, wm.Rank(c, i));
+      if (i < values.size() && values[i] == c) {
+        ASSERT_EQ(i, wm.Select(c, count));
+        ++count;
+      }
+    }
+    ASSERT_FALSE(wm.Select(c, count));
+  }
+
+  for (size_t from = 0; from <= values.size(); from += 7) {
+    for (size_t to = from; to <= values.size(); to += 5) {
+      std::vector<uint64_t> sorted(values.begin() + from, values.begin() + to);
+      std::sort(sorted.begin(), sorted.end());
+      for (size_t k = 0; k < sorted.size(); ++k)
+        ASSERT_EQ(sorted[k], wm.Quantile(from, to, k));
+
+      for (uint64_t lo = 0; lo <= maxValue + 1; lo += 3) {
+        for (uint64_t hi = lo; hi <= maxValue + 2; hi += 2) {
+          const auto expected = std::lower_bound(sorted.begin(), sorted.end(), hi) -
+                                std::lower_bound(sorted.begin(), sorted.end(), lo);
+          ASSERT_EQ(static_cast<uint64_t>(expected), wm.RangeFreq(from, to, lo, hi));
+        }
+      }
+    }
+  }
+}
+}  // namespace
+
+TEST(WaveletMatrix, Smoke) {
+  const std::vector<uint64_t> values = {5, 4, 5, 5, 2, 1, 5, 6, 1, 3, 5, 0};
+  const algo::WaveletMatrix wm(values, 1 /* numThreads */);
+
+  ASSERT_EQ(3, wm.NumLevels());
+  ASSERT_EQ(5, wm.Access(0));
+  ASSERT_EQ(0, wm.Access(11));
+
+  ASSERT_EQ(5, wm.Rank(5, values.size()));
+  ASSERT_EQ(2, wm.Rank(5, 3));
+  ASSERT_EQ(0, wm.Rank(7, values.size()));
+  ASSERT_EQ(0, wm.Rank(100, values.size()));
+
+  ASSERT_EQ(6, wm.Select(5, 3));
+  ASSERT_FALSE(wm.Select(5, 5));
+  ASSERT_FALSE(wm.Select(100, 0));
+
+  ASSERT_EQ(0, wm.Quantile(0, values.size(), 0));
+  ASSERT_EQ(6, wm.Quantile(0, values.size(), values.size() - 1));
+  ASSERT_EQ(2, wm.Quantile(4, 9, 2));
+
+  ASSERT_EQ(7, wm.RangeFreq(0, values.size(), 4, 100));
+  ASSERT_EQ(0, wm.RangeFreq(0, values.size(), 7, 100));
+}
+
+TEST(WaveletMatrix, Empty) {
+  const algo::WaveletMatrix wm(std::vector<uint64_t>{});
+  ASSERT_EQ(0, wm.Size());
+  ASSERT_EQ(0, wm.Rank(0, 0));
+  ASSERT_FALSE(wm.Select(0, 0));
+  ASSERT_EQ(0, wm.RangeFreq(0, 0, 0, 10));
+}
+
+TEST(WaveletMatrix, Random) {
+  std::mt19937 engine(0 /* seed */);
+  for (const uint64_t alphabet : {1, 2, 17, 64}) {
+    for (const size_t size : {1, 63, 64, 300}) {
+      std::uniform_int_distribution<uint64_t> dist(0, alphabet - 1);
+      std::vector<uint64_t> values(size);
+      for (auto& value : values)
+        value = dist(engine);
+
+      TestWaveletMatrix(values, 1 /* numThreads */);
+      TestWaveletMatrix(values, 4 /* numThreads */);
+    }
+  }
+}
+
+TEST(WaveletMatrix, LargeValues) {
+  std::mt19937_64 engine(0 /* seed */);
+  std::vector<uint64_t> values(1000);
+  for (auto& value : values)
+    value = engine();
+  values[17] = UINT64_MAX;
+
+  const algo::WaveletMatrix wm(values, 3 /* numThreads */);
+  ASSERT_EQ(64, wm.NumLevels());
+
+  auto sorted = values;
+  std::sort(sorted.begin(), sorted.end());
+  for (size_t i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(values[i], wm.Access(i));
+    ASSERT_EQ(i, wm.Select(values[i], 0));
+    ASSERT_EQ(sorted[i], wm.Quantile(0, values.size(), i));
+  }
+  ASSERT_EQ(values.size(), wm.RangeFreq(0, values.size(), 0, UINT64_MAX) + 1);
+}
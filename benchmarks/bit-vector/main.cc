@@ -0,0 +1,110 @@
+#include "bits/bit_vector.h"
+#include "bits/bits.h"
+#include "common/timing.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace algo;
+using namespace bench;
+using namespace std;
+
+namespace {
+// Returns bit vector with random blocks, except the last one, which
+// is left zero to keep bits after NumBits() zero.
+BitVector Random(uint64_t numBits, mt19937_64& engine) {
+  BitVector bits(numBits);
+  for (uint64_t i = 0; i + 1 < bits.NumBlocks(); ++i)
+    bits.Block(i) = engine();
+  return bits;
+}
+}  // namespace
+
+// Usage: bit-vector [number of bits] [number of repetitions]
+int main(int argc, char* argv[]) {
+  const uint64_t numBits = argc > 1 ? atoll(argv[1]) : 100000000;
+  const int times = argc > 2 ? atoi(argv[2]) : 10;
+
+  mt19937_64 engine(0);
+  BitVector lhs = Random(numBits, engine);
+  const BitVector rhs = Random(numBits, engine);
+  BitVector out(numBits);
+
+  printf("bits: %llu, repetitions: %d\n", static_cast<unsigned long long>(numBits), times);
+
+  const double naiveAnd = AvgMs(times, [&]() {
+    for (uint64_t i = 0; i < out.NumBlocks(); ++i)
+      out.Block(i) = lhs.Block(i) & rhs.Block(i);
+  });
+  const double bulkAnd = AvgMs(times, [&]() { BitVector::And(lhs, rhs, out); });
+  printf("And (out-of-place): naive %.3f ms, bulk %.3f ms\n", naiveAnd, bulkAnd);
+
+  const double naiveAndNot = AvgMs(times, [&]() {
+    for (uint64_t i = 0; i < lhs.NumBlocks(); ++i)
+      lhs.Block(i) &= ~rhs.Block(i);
+  });
+  const double bulkAndNot = AvgMs(times, [&]() { lhs.AndNot(rhs); });
+  printf("AndNot (in-place):  naive %.3f ms, bulk %.3f ms\n", naiveAndNot, bulkAndNot);
+
+  uint64_t naiveCount = 0;
+  uint64_t bulkCount = 0;
+  const double naivePopCount = AvgMs(times, [&]() {
+    naiveCount = 0;
+    for (uint64_t i = 0; i < rhs.NumBlocks(); ++i)
+      naiveCount += PopCount(rhs.Block(i));
+  });
+  const double bulkPopCount = AvgMs(times, [&]() { bulkCount = rhs.PopCount(); });
+  printf("PopCount:           naive %.3f ms, bulk %.3f ms\n", naivePopCount, bulkPopCount);
+
+  if (naiveCount != bulkCount) {
+    fprintf(stderr, "PopCount error\n");
+    return 1;
+  }
+
+  // Enumerates ones of a sparse bit vector.
+  BitVector sparse(numBits);
+  for (uint64_t i = 0; i < numBits / 100; ++i)
+    sparse.Set(engine() % numBits);
+
+  uint64_t naiveSum = 0;
+  uint64_t forEachSum = 0;
+  uint64_t nextSum = 0;
+  uint64_t decodeSum = 0;
+  const double naiveEnum = AvgMs(times, [&]() {
+    naiveSum = 0;
+    for (uint64_t i = 0; i < sparse.NumBits(); ++i) {
+      if (sparse.Test(i))
+        naiveSum += i;
+    }
+  });
+  const double forEachEnum = AvgMs(times, [&]() {
+    forEachSum = 0;
+    sparse.ForEachSetBit([&](uint64_t i) { forEachSum += i; });
+  });
+  const double nextEnum = AvgMs(times, [&]() {
+    nextSum = 0;
+    for (auto i = sparse.NextSetBit(0); i; i = sparse.NextSetBit(*i + 1))
+      nextSum += *i;
+  });
+  const double decodeEnum = AvgMs(times, [&]() {
+    decodeSum = 0;
+    vector<uint64_t> buffer(256);
+    uint64_t from = 0;
+    while (const size_t n = sparse.DecodeSetBits(from, buffer)) {
+      for (size_t i = 0; i < n; ++i)
+        decodeSum += buffer[i];
+      from = buffer[n - 1] + 1;
+    }
+  });
+  printf("Set bits (1%%):      naive %.3f ms, ForEachSetBit %.3f ms, NextSetBit %.3f ms, DecodeSetBits %.3f ms\n",
+         naiveEnum, forEachEnum, nextEnum, decodeEnum);
+
+  if (naiveSum != forEachSum || naiveSum != nextSum || naiveSum != decodeSum) {
+    fprintf(stderr, "Set bits enumeration error\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,154 @@
+#include "bits/bits.h"
+#include "common/timing.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace algo;
+using namespace bench;
+using namespace std;
+
+namespace {
+// Naive versions of the primitives, bit by bit.
+uint8_t NaiveSelectInWord(uint64_t x, uint8_t k) {
+  for (uint8_t i = 0;; ++i) {
+    if (((x >> i) & 1) && k-- == 0)
+      return i;
+  }
+}
+
+uint64_t NaivePopCountBytes(uint64_t x) {
+  uint64_t result = 0;
+  for (unsigned byte = 0; byte < 64; byte += 8) {
+    uint64_t count = 0;
+    for (unsigned i = byte; i < byte + 8; ++i)
+      count += (x >> i) & 1;
+    result |= count << byte;
+  }
+  return result;
+}
+
+uint64_t NaivePext(uint64_t x, uint64_t mask) {
+  uint64_t result = 0;
+  for (unsigned i = 0, j = 0; i < 64; ++i) {
+    if ((mask >> i) & 1)
+      result |= ((x >> i) & 1) << j++;
+  }
+  return result;
+}
+
+uint64_t NaivePdep(uint64_t x, uint64_t mask) {
+  uint64_t result = 0;
+  for (unsigned i = 0, j = 0; i < 64; ++i) {
+    if ((mask >> i) & 1)
+      result |= ((x >> j++) & 1) << i;
+  }
+  return result;
+}
+
+uint64_t NaiveMorton2Encode(uint32_t x, uint32_t y) {
+  uint64_t code = 0;
+  for (unsigned i = 0; i < 32; ++i)
+    code |= (static_cast<uint64_t>((x >> i) & 1) << (2 * i)) | (static_cast<uint64_t>((y >> i) & 1) << (2 * i + 1));
+  return code;
+}
+
+uint64_t NaiveMorton3Encode(uint32_t x, uint32_t y, uint32_t z) {
+  uint64_t code = 0;
+  for (unsigned i = 0; i < 21; ++i) {
+    code |= static_cast<uint64_t>((x >> i) & 1) << (3 * i);
+    code |= static_cast<uint64_t>((y >> i) & 1) << (3 * i + 1);
+    code |= static_cast<uint64_t>((z >> i) & 1) << (3 * i + 2);
+  }
+  return code;
+}
+
+// Runs |fast| and |naive| on all |xs|, reports both timings and
+// returns false when results differ.
+template <typename Fast, typename Naive>
+bool Compare(const char* name, const vector<uint64_t>& xs, Fast&& fast, Naive&& naive) {
+  uint64_t fastSum = 0;
+  const double fastNs = NsPerQuery(xs.size(), [&]() {
+    for (size_t i = 0; i < xs.size(); ++i)
+      fastSum += fast(xs[i], xs[xs.size() - 1 - i]);
+  });
+
+  uint64_t naiveSum = 0;
+  const double naiveNs = NsPerQuery(xs.size(), [&]() {
+    for (size_t i = 0; i < xs.size(); ++i)
+      naiveSum += naive(xs[i], xs[xs.size() - 1 - i]);
+  });
+
+  printf("%-22s %8.2f ns/op %8.2f ns/op\n", name, fastNs, naiveNs);
+  if (fastSum != naiveSum) {
+    fprintf(stderr, "%s error\n", name);
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+// Usage: bits [number of words]
+//
+// Compares primitives from bits/bits.h with naive loops over bits.
+// Build with USE_NATIVE_ARCH=ON to get BMI2 versions of SelectInWord,
+// Pdep, Pext and Morton codes, broadword versions are used otherwise.
+int main(int argc, char* argv[]) {
+  const size_t numWords = argc > 1 ? atoll(argv[1]) : 10000000;
+
+  mt19937_64 engine(0);
+  vector<uint64_t> xs(numWords);
+  for (auto& x : xs)
+    x = engine() | 1;
+
+  printf("%-22s %14s %14s\n", "", "bits.h", "naive");
+  bool ok = true;
+  ok &= Compare(
+      "SelectInWord", xs, [](uint64_t x, uint64_t y) { return SelectInWord(x, y % PopCount(x)); },
+      [](uint64_t x, uint64_t y) { return NaiveSelectInWord(x, y % PopCount(x)); });
+  ok &= Compare(
+      "PopCountBytes", xs, [](uint64_t x, uint64_t) { return PopCountBytes(x); },
+      [](uint64_t x, uint64_t) { return NaivePopCountBytes(x); });
+  ok &= Compare(
+      "Pext", xs, [](uint64_t x, uint64_t y) { return Pext(x, y); },
+      [](uint64_t x, uint64_t y) { return NaivePext(x, y); });
+  ok &= Compare(
+      "PextBroadword", xs, [](uint64_t x, uint64_t y) { return PextBroadword(x, y); },
+      [](uint64_t x, uint64_t y) { return NaivePext(x, y); });
+  ok &= Compare(
+      "Pdep", xs, [](uint64_t x, uint64_t y) { return Pdep(x, y); },
+      [](uint64_t x, uint64_t y) { return NaivePdep(x, y); });
+  ok &= Compare(
+      "PdepBroadword", xs, [](uint64_t x, uint64_t y) { return PdepBroadword(x, y); },
+      [](uint64_t x, uint64_t y) { return NaivePdep(x, y); });
+  ok &= Compare(
+      "Morton2Encode", xs, [](uint64_t x, uint64_t) { return Morton2Encode(x, x >> 32); },
+      [](uint64_t x, uint64_t) { return NaiveMorton2Encode(x, x >> 32); });
+  ok &= Compare(
+      "Morton2Decode", xs,
+      [](uint64_t x, uint64_t) {
+        const auto [a, b] = Morton2Decode(x);
+        return a ^ (static_cast<uint64_t>(b) << 32);
+      },
+      [](uint64_t x, uint64_t) { return NaivePext(x, L(2)) ^ (NaivePext(x, H(2)) << 32); });
+  ok &= Compare(
+      "Morton3Encode", xs,
+      [](uint64_t x, uint64_t) { return Morton3Encode(x & 0x1FFFFF, (x >> 21) & 0x1FFFFF, (x >> 42) & 0x1FFFFF); },
+      [](uint64_t x, uint64_t) {
+        return NaiveMorton3Encode(x & 0x1FFFFF, (x >> 21) & 0x1FFFFF, (x >> 42) & 0x1FFFFF);
+      });
+  ok &= Compare(
+      "Morton3Decode", xs,
+      [](uint64_t x, uint64_t) {
+        const auto [a, b, c] = Morton3Decode(x);
+        return a ^ (static_cast<uint64_t>(b) << 21) ^ (static_cast<uint64_t>(c) << 42);
+      },
+      [](uint64_t x, uint64_t) {
+        return NaivePext(x, L(3) & ~H(64)) ^ (NaivePext(x, L(3) << 1) << 21) ^
+               (NaivePext(x, L(3) << 2) << 42);
+      });
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+#include "common/timing.h"
+#include "sequences/blocked_fenwick.h"
+#include "sequences/fenwick.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace algo;
+using namespace bench;
+using namespace std;
+
+namespace {
+struct Result {
+  double m_add{};
+  double m_sum{};
+  uint32_t m_checksum{};
+};
+
+// Runs random Add() calls and then random Sum() calls on |tree|.
+template <typename Tree>
+Result Run(Tree& tree, const vector<size_t>& indices) {
+  Result result;
+  result.m_add = NsPerQuery(indices.size(), [&]() {
+    for (const auto index : indices)
+      tree.Add(index, static_cast<uint32_t>(index));
+  });
+  result.m_sum = NsPerQuery(indices.size(), [&]() {
+    for (const auto index : indices)
+      result.m_checksum += tree.Sum(index);
+  });
+  return result;
+}
+}  // namespace
+
+// Usage: blocked-fenwick [max number of elements] [number of queries]
+//
+// Compares Fenwick and BlockedFenwick over 32-bit counters, for sizes
+// from 10^4 up to the max size by powers of 10. Each tree takes about
+// 4 bytes per element, so 10^9 elements need 4GB per tree.
+int main(int argc, char* argv[]) {
+  const size_t maxSize = argc > 1 ? atoll(argv[1]) : 100000000;
+  const size_t numQueries = argc > 2 ? atoll(argv[2]) : 1000000;
+
+  mt19937_64 engine(0);
+  vector<size_t> indices(numQueries);
+
+  printf("%12s %14s %14s %14s %14s\n", "Size", "Fenwick Add", "Blocked Add", "Fenwick Sum", "Blocked Sum");
+  for (size_t size = 10000; size <= maxSize; size *= 10) {
+    for (auto& index : indices)
+      index = engine() % size;
+
+    Result fenwick;
+    {
+      Fenwick<uint32_t> tree(size);
+      fenwick = Run(tree, indices);
+    }
+    Result blocked;
+    {
+      BlockedFenwick<uint32_t> tree(size);
+      blocked = Run(tree, indices);
+    }
+
+    if (fenwick.m_checksum != blocked.m_checksum) {
+      fprintf(stderr, "BlockedFenwick error\n");
+      return 1;
+    }
+    printf("%12zu %11.1f ns %11.1f ns %11.1f ns %11.1f ns\n", size, fenwick.m_add, blocked.m_add, fenwick.m_sum,
+           blocked.m_sum);
+  }
+  return 0;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace bench {
+// Runs |fn| and returns elapsed time in nanoseconds.
+template <typename Fn>
+double Ns(Fn&& fn) {
+  const auto start = std::chrono::steady_clock::now();
+  fn();
+  const auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(finish - start).count();
+}
+
+// Runs |fn| and returns elapsed time in milliseconds.
+template <typename Fn>
+double Ms(Fn&& fn) {
+  return Ns(fn) / 1e6;
+}
+
+// Runs |fn| |times| times and returns average time in milliseconds.
+template <typename Fn>
+double AvgMs(size_t times, Fn&& fn) {
+  return Ms([&]() {
+           for (size_t i = 0; i < times; ++i)
+             fn();
+         }) /
+         times;
+}
+
+// Runs |fn| and returns average time in nanoseconds per each of |n|
+// queries.
+template <typename Fn>
+double NsPerQuery(size_t n, Fn&& fn) {
+  return Ns(fn) / n;
+}
+}  // namespace bench
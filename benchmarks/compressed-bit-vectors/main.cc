@@ -0,0 +1,88 @@
+#include "bits/bit_vector.h"
+#include "bits/elias_fano.h"
+#include "bits/interleaved_rs_table.h"
+#include "bits/rank_support.h"
+#include "bits/rrr.h"
+#include "bits/rs_table.h"
+#include "common/timing.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace algo;
+using namespace bench;
+using namespace std;
+
+namespace {
+// Prints size and query times of |table|, where |sizeInBytes| is the
+// total footprint of the structure, including bits.
+template <RankSupport Table>
+void Report(const char* name, const Table& table, uint64_t sizeInBytes, const vector<uint64_t>& ns,
+            uint64_t& checksum) {
+  const double rank = NsPerQuery(ns.size(), [&]() {
+    for (const auto n : ns)
+      checksum += table.Rank1(n);
+  });
+
+  const double bitsPerOne = table.NumOnes() == 0 ? 0 : 8.0 * sizeInBytes / table.NumOnes();
+  const double bitsPerBit = 8.0 * sizeInBytes / table.NumBits();
+  printf("  %-20s %10.3f bits/elem %8.3f bits/bit %8.2f ns/rank1", name, bitsPerOne, bitsPerBit, rank);
+
+  if constexpr (requires { table.Select1(0); }) {
+    if (table.NumOnes() != 0) {
+      const double select = NsPerQuery(ns.size(), [&]() {
+        for (const auto n : ns)
+          checksum += table.Select1(n % table.NumOnes());
+      });
+      printf(" %8.2f ns/select1", select);
+    }
+  }
+  printf("\n");
+}
+}  // namespace
+
+// Usage: compressed-bit-vectors [log2 of number of bits] [number of queries]
+int main(int argc, char* argv[]) {
+  const uint64_t logNumBits = argc > 1 ? atoi(argv[1]) : 26;
+  const size_t numQueries = argc > 2 ? atoll(argv[2]) : 1000000;
+
+  mt19937_64 engine(0);
+
+  vector<uint64_t> ns(numQueries);
+  for (auto& n : ns)
+    n = engine() % ((static_cast<uint64_t>(1) << logNumBits) + 1);
+
+  printf("bits: 2^%d, queries: %zu\n", static_cast<int>(logNumBits), numQueries);
+  for (const double density : {0.001, 0.01, 0.1, 0.5, 0.9, 0.99}) {
+    bernoulli_distribution bit(density);
+    BitVector bv(static_cast<uint64_t>(1) << logNumBits);
+    for (uint64_t i = 0; i < bv.NumBits(); ++i) {
+      if (bit(engine))
+        bv.Set(i);
+    }
+
+    uint64_t checksum = 0;
+    printf("density %.3f:\n", density);
+    {
+      const RSTable table(bv);
+      Report("RSTable", table, 8 * bv.NumBlocks() + table.SizeInBytes(), ns, checksum);
+    }
+    {
+      const InterleavedRSTable table(bv);
+      Report("InterleavedRSTable", table, table.SizeInBytes(), ns, checksum);
+    }
+    {
+      const EliasFano table(bv);
+      Report("EliasFano", table, table.SizeInBytes(), ns, checksum);
+    }
+    {
+      const RRR table(bv);
+      Report("RRR", table, table.SizeInBytes(), ns, checksum);
+    }
+    printf("  checksum: %llu\n", static_cast<unsigned long long>(checksum));
+  }
+  return 0;
+}
@@ -0,0 +1,88 @@
+#include "bits/concurrent_dictionary.h"
+#include "bits/dictionary.h"
+#include "common/timing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace algo;
+using namespace bench;
+using namespace std;
+
+namespace {
+constexpr uint64_t LOG_SIZE = 24;
+
+// Runs |fn(t)| on |numThreads| threads and returns throughput in
+// millions of operations per second, given |numOps| operations per
+// thread.
+template <typename Fn>
+double MOpsPerSec(unsigned numThreads, size_t numOps, Fn&& fn) {
+  const double ns = Ns([&]() {
+    vector<thread> threads;
+    for (unsigned t = 0; t < numThreads; ++t)
+      threads.emplace_back(fn, t);
+    for (auto& thread : threads)
+      thread.join();
+  });
+  return numThreads * numOps / (ns / 1000);
+}
+
+// Runs a mix of Set(), Clear() and Succ() on random keys. Returns
+// checksum of results, so that queries are not optimized out.
+template <typename Dict, typename Lock>
+uint64_t Work(Dict& dict, Lock&& lock, unsigned seed, size_t numOps) {
+  mt19937_64 engine(seed);
+  uint64_t checksum = 0;
+  for (size_t i = 0; i < numOps; ++i) {
+    const auto r = engine();
+    const auto key = r % (static_cast<uint64_t>(1) << LOG_SIZE);
+    [[maybe_unused]] const auto guard = lock();
+    switch ((r >> 60) % 4) {
+      case 0: dict.Set(key); break;
+      case 1: dict.Clear(key); break;
+      default: checksum += dict.Succ(key).value_or(0); break;
+    }
+  }
+  return checksum;
+}
+}  // namespace
+
+// Usage: concurrent-dictionary [max number of threads] [operations per thread]
+//
+// Compares ConcurrentDictionary with Dictionary guarded by a global
+// mutex, on a mix of 25% Set(), 25% Clear() and 50% Succ() over 2^24
+// keys, for 1, 2, 4, ... threads.
+int main(int argc, char* argv[]) {
+  const unsigned maxThreads = argc > 1 ? atoi(argv[1]) : max(thread::hardware_concurrency(), 1u);
+  const size_t numOps = argc > 2 ? atoll(argv[2]) : 2000000;
+
+  atomic<uint64_t> checksum{0};
+  printf("Threads   Mutex, Mops/s   Atomic, Mops/s\n");
+  for (unsigned numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+    auto locked = make_unique<Dictionary<LOG_SIZE>>();
+    mutex mu;
+    const double mutexed = MOpsPerSec(numThreads, numOps, [&](unsigned t) {
+      checksum += Work(*locked, [&]() { return unique_lock<mutex>(mu); }, t, numOps);
+    });
+
+    auto concurrent = make_unique<ConcurrentDictionary<LOG_SIZE>>();
+    const double atomic = MOpsPerSec(numThreads, numOps, [&](unsigned t) {
+      checksum += Work(*concurrent, []() { return 0; }, t, numOps);
+    });
+
+    printf("%7u   %13.1f   %14.1f\n", numThreads, mutexed, atomic);
+  }
+
+  // Results of concurrent runs are not deterministic, so the checksum
+  // is only printed.
+  printf("Checksum: %llu\n", static_cast<unsigned long long>(checksum.load()));
+  return 0;
+}
@@ -0,0 +1,58 @@
+#include "common/timing.h"
+#include "sequences/compact_dsu.h"
+#include "sequences/concurrent_dsu.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace algo;
+using namespace bench;
+using namespace std;
+
+// Usage: concurrent-dsu [number of nodes] [number of edges] [max number of threads]
+//
+// Computes connected components of a random graph with ParallelUnite()
+// on 1, 2, 4, ... threads, and with a sequential CompactDSU as a
+// baseline.
+int main(int argc, char* argv[]) {
+  const uint32_t n = argc > 1 ? atoi(argv[1]) : 10000000;
+  const size_t m = argc > 2 ? atoll(argv[2]) : 50000000;
+  const unsigned maxThreads = argc > 3 ? atoi(argv[3]) : max(thread::hardware_concurrency(), 1u);
+
+  mt19937 engine(0);
+  vector<pair<uint32_t, uint32_t>> edges(m);
+  for (auto& [u, v] : edges) {
+    u = engine() % n;
+    v = engine() % n;
+  }
+
+  uint32_t expected = 0;
+  const double sequential = Ms([&]() {
+    CompactDSU dsu(n);
+    for (const auto& [u, v] : edges)
+      dsu.Union(u, v);
+    expected = dsu.NumComponents();
+  });
+  printf("%u nodes, %zu edges, %u components\n", n, m, expected);
+  printf("CompactDSU: %.1f ms\n", sequential);
+
+  double single = 0;
+  for (unsigned numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+    ConcurrentDSU dsu(n);
+    const double ms = Ms([&]() { ParallelUnite(dsu, edges, numThreads); });
+    if (dsu.NumComponents() != expected) {
+      fprintf(stderr, "ParallelUnite error on %u threads\n", numThreads);
+      return 1;
+    }
+    if (numThreads == 1)
+      single = ms;
+    printf("ConcurrentDSU, %3u threads: %.1f ms, speedup %.2f\n", numThreads, ms, single / ms);
+  }
+  return 0;
+}
@@ -0,0 +1,79 @@
+#include "bits/dictionary.h"
+#include "common/timing.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace algo;
+using namespace bench;
+using namespace std;
+
+namespace {
+using Dict = Dictionary<32>;
+
+}  // namespace
+
+// Usage: dictionary [number of keys]
+//
+// Compares building Dictionary<32> key by key with the bulk
+// constructor, and enumerating keys via Succ() with ForEach(). A
+// single pass summing the keys is a lower bound for both.
+int main(int argc, char* argv[]) {
+  const size_t numKeys = argc > 1 ? atoll(argv[1]) : 100000000;
+
+  mt19937_64 engine(0);
+  vector<uint64_t> keys(numKeys);
+  for (auto& key : keys)
+    key = engine() % Dict::SIZE;
+  sort(keys.begin(), keys.end());
+  keys.erase(unique(keys.begin(), keys.end()), keys.end());
+
+  uint64_t expected = 0;
+  const double pass = Ms([&]() {
+    for (const auto key : keys)
+      expected += key;
+  });
+
+  double set = 0;
+  {
+    auto dict = make_unique<Dict>();
+    set = Ms([&]() {
+      for (const auto key : keys)
+        dict->Set(key);
+    });
+  }
+
+  auto dict = make_unique<Dict>();
+  const double bulk = Ms([&]() { dict->SetSorted(keys.data(), keys.data() + keys.size(), 0 /* base */); });
+
+  uint64_t succSum = 0;
+  const double succ = Ms([&]() {
+    for (auto key = dict->Min(); key; key = dict->Succ(*key))
+      succSum += *key;
+  });
+
+  uint64_t forEachSum = 0;
+  const double forEach = Ms([&]() { dict->ForEach(0, Dict::SIZE, [&](uint64_t key) { forEachSum += key; }); });
+
+  uint64_t reverseSum = 0;
+  const double reverse = Ms([&]() { dict->ForEachReverse(0, Dict::SIZE, [&](uint64_t key) { reverseSum += key; }); });
+
+  if (succSum != expected || forEachSum != expected || reverseSum != expected) {
+    fprintf(stderr, "Enumeration error\n");
+    return 1;
+  }
+
+  printf("%zu keys:\n", keys.size());
+  printf("  Memory pass:    %.1f ms\n", pass);
+  printf("  Set:            %.1f ms\n", set);
+  printf("  Bulk build:     %.1f ms\n", bulk);
+  printf("  Succ:           %.1f ms\n", succ);
+  printf("  ForEach:        %.1f ms\n", forEach);
+  printf("  ForEachReverse: %.1f ms\n", reverse);
+  return 0;
+}
@@ -0,0 +1,159 @@
+#include "common/timing.h"
+#include "sequences/bucket_queue.h"
+#include "sequences/dary_heap.h"
+#include "sequences/indexed_heap.h"
+#include "sequences/radix_heap.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "sequences/heap.h"
+
+using namespace algo;
+using namespace bench;
+using namespace std;
+
+namespace {
+constexpr uint64_t INF = numeric_limits<uint64_t>::max();
+
+// Directed graph in the compressed sparse row format.
+struct Graph {
+  vector<uint32_t> m_offsets;
+  vector<uint32_t> m_targets;
+  vector<uint32_t> m_weights;
+};
+
+Graph RandomGraph(uint32_t numVertices, size_t numEdges, uint32_t maxWeight) {
+  mt19937_64 engine(0);
+  vector<pair<uint32_t, uint32_t>> edges(numEdges);
+  for (auto& [from, to] : edges) {
+    from = engine() % numVertices;
+    to = engine() % numVertices;
+  }
+
+  Graph graph;
+  graph.m_offsets.assign(numVertices + 1, 0);
+  for (const auto& edge : edges)
+    ++graph.m_offsets[edge.first + 1];
+  for (uint32_t v = 0; v < numVertices; ++v)
+    graph.m_offsets[v + 1] += graph.m_offsets[v];
+
+  graph.m_targets.resize(numEdges);
+  graph.m_weights.resize(numEdges);
+  vector<uint32_t> next(graph.m_offsets.begin(), graph.m_offsets.end() - 1);
+  for (const auto& [from, to] : edges) {
+    const auto e = next[from]++;
+    graph.m_targets[e] = to;
+    graph.m_weights[e] = 1 + engine() % maxWeight;
+  }
+  return graph;
+}
+
+// Dijkstra with lazy deletion: a vertex is pushed on each improvement
+// of its distance, and stale entries are skipped on pops. The |heap|
+// should be empty.
+template <typename Heap>
+vector<uint64_t> LazyDijkstra(const Graph& graph, uint32_t source, Heap heap) {
+  vector<uint64_t> dist(graph.m_offsets.size() - 1, INF);
+  dist[source] = 0;
+  heap.Push(pair<uint64_t, uint32_t>{0, source});
+  while (!heap.Empty()) {
+    const auto [d, u] = heap.Min();
+    heap.Pop();
+    if (d != dist[u])
+      continue;
+    for (auto e = graph.m_offsets[u]; e != graph.m_offsets[u + 1]; ++e) {
+      const auto v = graph.m_targets[e];
+      const auto candidate = d + graph.m_weights[e];
+      if (candidate < dist[v]) {
+        dist[v] = candidate;
+        heap.Push(pair<uint64_t, uint32_t>{candidate, v});
+      }
+    }
+  }
+  return dist;
+}
+
+// Dijkstra with decrease-key: each vertex is in the heap at most once.
+vector<uint64_t> IndexedDijkstra(const Graph& graph, uint32_t source) {
+  const auto numVertices = graph.m_offsets.size() - 1;
+  vector<uint64_t> dist(numVertices, INF);
+  IndexedHeap<uint64_t> heap(numVertices);
+  dist[source] = 0;
+  heap.Push(source, 0);
+  while (!heap.Empty()) {
+    const auto u = heap.MinId();
+    const auto d = heap.MinValue();
+    heap.Pop();
+    for (auto e = graph.m_offsets[u]; e != graph.m_offsets[u + 1]; ++e) {
+      const auto v = graph.m_targets[e];
+      const auto candidate = d + graph.m_weights[e];
+      if (candidate < dist[v]) {
+        if (heap.Contains(v))
+          heap.DecreaseKey(v, candidate);
+        else
+          heap.Push(v, candidate);
+        dist[v] = candidate;
+      }
+    }
+  }
+  return dist;
+}
+
+uint64_t Checksum(const vector<uint64_t>& dist) {
+  uint64_t checksum = 0;
+  for (const auto d : dist)
+    checksum = checksum * 31 + d;
+  return checksum;
+}
+}  // namespace
+
+// Usage: dijkstra [number of vertices] [number of edges] [max weight]
+//
+// Runs single-source shortest paths on a random graph, with lazy
+// deletion over Heap, DaryHeap and monotone queues, and with
+// decrease-key over IndexedHeap.
+int main(int argc, char* argv[]) {
+  const uint32_t numVertices = argc > 1 ? atoll(argv[1]) : 1000000;
+  const size_t numEdges = argc > 2 ? atoll(argv[2]) : 10000000;
+  const uint32_t maxWeight = argc > 3 ? atoll(argv[3]) : 1000000;
+
+  const auto graph = RandomGraph(numVertices, numEdges, maxWeight);
+
+  uint64_t expected = 0;
+  bool ok = true;
+  const auto run = [&](const char* name, auto&& dijkstra) {
+    vector<uint64_t> dist;
+    const double ms = Ms([&]() { dist = dijkstra(graph, 0 /* source */); });
+    printf("%-24s %10.1f ms\n", name, ms);
+
+    const auto checksum = Checksum(dist);
+    if (expected == 0)
+      expected = checksum;
+    if (checksum != expected) {
+      fprintf(stderr, "%s error\n", name);
+      ok = false;
+    }
+  };
+
+  printf("%u vertices, %zu edges:\n", numVertices, numEdges);
+  run("Lazy, Heap", [](const Graph& graph, uint32_t source) {
+    return LazyDijkstra(graph, source, Heap<pair<uint64_t, uint32_t>>());
+  });
+  run("Lazy, DaryHeap", [](const Graph& graph, uint32_t source) {
+    return LazyDijkstra(graph, source, DaryHeap<pair<uint64_t, uint32_t>>());
+  });
+  run("Lazy, RadixHeap", [](const Graph& graph, uint32_t source) {
+    return LazyDijkstra(graph, source, RadixHeap<uint32_t>());
+  });
+  run("Lazy, BucketQueue", [&](const Graph& graph, uint32_t source) {
+    return LazyDijkstra(graph, source, BucketQueue<uint32_t>(maxWeight));
+  });
+  run("Decrease-key, IndexedHeap", IndexedDijkstra);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+#include "common/timing.h"
+#include "sequences/compact_dsu.h"
+#include "sequences/dsu.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace algo;
+using namespace bench;
+using namespace std;
+
+namespace {
+using Edges = vector<pair<uint32_t, uint32_t>>;
+
+// Unites all |edges|, then finds roots of all nodes. Returns a
+// checksum that does not depend on the choice of roots.
+template <typename Dsu>
+uint64_t Run(Dsu& dsu, uint32_t n, const Edges& edges) {
+  uint64_t checksum = 0;
+  for (const auto& [u, v] : edges)
+    checksum += dsu.Union(u, v);
+  for (uint32_t u = 0; u < n; ++u)
+    checksum += dsu.GetParent(u) == dsu.GetParent(n - 1 - u);
+  return checksum + dsu.NumComponents();
+}
+
+bool Compare(const char* name, uint32_t n, const Edges& edges) {
+  uint64_t expected = 0;
+  double dsuMs = 0;
+  {
+    DSU dsu(n);
+    dsuMs = Ms([&]() { expected = Run(dsu, n, edges); });
+  }
+
+  uint64_t actual = 0;
+  double compactMs = 0;
+  {
+    CompactDSU dsu(n);
+    compactMs = Ms([&]() { actual = Run(dsu, n, edges); });
+  }
+
+  printf("%-12s %10.1f ms %12.1f ms\n", name, dsuMs, compactMs);
+  if (expected != actual) {
+    fprintf(stderr, "%s: CompactDSU error\n", name);
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+// Usage: dsu [number of nodes]
+//
+// Compares DSU and CompactDSU on:
+// * random: 2n random unions;
+// * chain: unions (i, i + 1) in order, each joining a singleton to
+//   the growing component;
+// * binomial: unions of equal-sized components, pairs at distance 1,
+//   2, 4, ..., which gives trees of maximal height for union by rank
+//   and size;
+// * reversed: unions (i, i + 1) in reverse order.
+// Each run is followed by finds from all nodes.
+int main(int argc, char* argv[]) {
+  const uint32_t n = argc > 1 ? atoi(argv[1]) : 10000000;
+
+  mt19937 engine(0);
+  Edges random(2 * static_cast<size_t>(n));
+  for (auto& [u, v] : random) {
+    u = engine() % n;
+    v = engine() % n;
+  }
+
+  Edges chain;
+  for (uint32_t i = 0; i + 1 < n; ++i)
+    chain.emplace_back(i, i + 1);
+
+  Edges binomial;
+  for (uint32_t step = 1; step < n; step *= 2) {
+    for (uint32_t i = 0; i + step < n; i += 2 * step)
+      binomial.emplace_back(i, i + step);
+  }
+
+  Edges reversed(chain.rbegin(), chain.rend());
+
+  printf("%-12s %13s %15s\n", "", "DSU", "CompactDSU");
+  bool ok = true;
+  ok &= Compare("random", n, random);
+  ok &= Compare("chain", n, chain);
+  ok &= Compare("binomial", n, binomial);
+  ok &= Compare("reversed", n, reversed);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+#include "common/timing.h"
+#include "sequences/fenwick.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace algo;
+using namespace bench;
+using namespace std;
+
+namespace {
+struct Rect {
+  size_t m_fromRow{};
+  size_t m_fromCol{};
+  size_t m_toRow{};
+  size_t m_toCol{};
+  int64_t m_value{};
+};
+
+// Naive grid with O(area) updates and sums.
+class Grid {
+public:
+  Grid(size_t numRows, size_t numCols) : m_numCols{numCols}, m_cells(numRows * numCols) {}
+
+  void Add(const Rect& rect) {
+    for (size_t i = rect.m_fromRow; i < rect.m_toRow; ++i) {
+      for (size_t j = rect.m_fromCol; j < rect.m_toCol; ++j)
+        m_cells[i * m_numCols + j] += rect.m_value;
+    }
+  }
+
+  int64_t Sum(const Rect& rect) const {
+    int64_t sum = 0;
+    for (size_t i = rect.m_fromRow; i < rect.m_toRow; ++i) {
+      for (size_t j = rect.m_fromCol; j < rect.m_toCol; ++j)
+        sum += m_cells[i * m_numCols + j];
+    }
+    return sum;
+  }
+
+private:
+  size_t m_numCols{};
+  vector<int64_t> m_cells;
+};
+
+pair<size_t, size_t> RandomRange(mt19937_64& engine, size_t size) {
+  size_t from = engine() % (size + 1);
+  size_t to = engine() % (size + 1);
+  if (from > to)
+    swap(from, to);
+  return {from, to};
+}
+
+// Runs |numOps| pairs of updates and sums on |tree| and on a naive
+// grid, prints time per pair and returns false on mismatch.
+template <typename Tree, typename Update>
+bool Compare(const char* name, Tree& tree, Grid& grid, const vector<Rect>& updates, const vector<Rect>& sums,
+             Update&& update) {
+  int64_t treeSum = 0;
+  const double treeNs = NsPerQuery(updates.size(), [&]() {
+    for (size_t i = 0; i < updates.size(); ++i) {
+      update(tree, updates[i]);
+      const auto& rect = sums[i];
+      treeSum += tree.Sum(rect.m_fromRow, rect.m_fromCol, rect.m_toRow, rect.m_toCol);
+    }
+  });
+
+  int64_t gridSum = 0;
+  const double gridNs = NsPerQuery(updates.size(), [&]() {
+    for (size_t i = 0; i < updates.size(); ++i) {
+      grid.Add(updates[i]);
+      gridSum += grid.Sum(sums[i]);
+    }
+  });
+
+  printf("%-16s %12.1f ns %12.1f ns\n", name, treeNs, gridNs);
+  if (treeSum != gridSum) {
+    fprintf(stderr, "%s error\n", name);
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+// Usage: fenwick-2d [number of rows] [number of columns] [number of operations]
+//
+// Compares Fenwick2D (point updates), RangeFenwick2D (rectangle
+// updates) and RangeFenwick (range updates on the first row) with a
+// naive grid, on pairs of a random update and a random rectangle sum.
+int main(int argc, char* argv[]) {
+  const size_t numRows = argc > 1 ? atoll(argv[1]) : 1024;
+  const size_t numCols = argc > 2 ? atoll(argv[2]) : 1024;
+  const size_t numOps = argc > 3 ? atoll(argv[3]) : 10000;
+
+  mt19937_64 engine(0);
+  vector<Rect> points(numOps);
+  vector<Rect> rects(numOps);
+  vector<Rect> ranges(numOps);
+  vector<Rect> sums(numOps);
+  vector<Rect> rangeSums(numOps);
+  for (size_t i = 0; i < numOps; ++i) {
+    const int64_t value = static_cast<int64_t>(engine() % 1000) - 500;
+
+    const size_t row = engine() % numRows;
+    const size_t col = engine() % numCols;
+    points[i] = Rect{row, col, row + 1, col + 1, value};
+
+    const auto [fromRow, toRow] = RandomRange(engine, numRows);
+    const auto [fromCol, toCol] = RandomRange(engine, numCols);
+    rects[i] = Rect{fromRow, fromCol, toRow, toCol, value};
+
+    const auto [from, to] = RandomRange(engine, numCols);
+    ranges[i] = Rect{0, from, 1, to, value};
+
+    const auto [sumFromRow, sumToRow] = RandomRange(engine, numRows);
+    const auto [sumFromCol, sumToCol] = RandomRange(engine, numCols);
+    sums[i] = Rect{sumFromRow, sumFromCol, sumToRow, sumToCol, 0};
+
+    const auto [sumFrom, sumTo] = RandomRange(engine, numCols);
+    rangeSums[i] = Rect{0, sumFrom, 1, sumTo, 0};
+  }
+
+  printf("%-16s %15s %15s\n", "", "Fenwick", "Naive grid");
+  bool ok = true;
+  {
+    Fenwick2D<int64_t> tree(numRows, numCols);
+    Grid grid(numRows, numCols);
+    ok &= Compare("Fenwick2D", tree, grid, points, sums,
+                  [](auto& tree, const Rect& rect) { tree.Add(rect.m_fromRow, rect.m_fromCol, rect.m_value); });
+  }
+  {
+    RangeFenwick2D<int64_t> tree(numRows, numCols);
+    Grid grid(numRows, numCols);
+    ok &= Compare("RangeFenwick2D", tree, grid, rects, sums, [](auto& tree, const Rect& rect) {
+      tree.Add(rect.m_fromRow, rect.m_fromCol, rect.m_toRow, rect.m_toCol, rect.m_value);
+    });
+  }
+  {
+    // Adapts RangeFenwick to the interface of 2D trees.
+    struct Row {
+      int64_t Sum(size_t, size_t fromCol, size_t, size_t toCol) const { return m_tree.Sum(fromCol, toCol); }
+      RangeFenwick<int64_t> m_tree;
+    } tree{RangeFenwick<int64_t>(numCols)};
+    Grid grid(1, numCols);
+    ok &= Compare("RangeFenwick", tree, grid, ranges, rangeSums, [](auto& tree, const Rect& rect) {
+      tree.m_tree.Add(rect.m_fromCol, rect.m_toCol, rect.m_value);
+    });
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+#include "common/timing.h"
+#include "sequences/fenwick.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <random>
+#include <vector>
+
+using namespace algo;
+using namespace bench;
+using namespace std;
+
+namespace {
+// Returns the smallest index such that fenwick.Sum(index + 1) >=
+// |target|, by a binary search over prefix sums.
+size_t BinarySearch(const Fenwick<uint64_t>& fenwick, uint64_t target) {
+  size_t lo = 0;
+  size_t hi = fenwick.Size();
+  while (lo < hi) {
+    const auto mid = lo + (hi - lo) / 2;
+    if (fenwick.Sum(mid + 1) < target)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+}  // namespace
+
+// Usage: fenwick [number of elements] [number of queries]
+//
+// Compares construction by Add() calls with the linear-time
+// constructor, and weighted sampling by LowerBound() with a binary
+// search over Sum().
+int main(int argc, char* argv[]) {
+  const size_t n = argc > 1 ? atoll(argv[1]) : 10000000;
+  const size_t numQueries = argc > 2 ? atoll(argv[2]) : 1000000;
+
+  mt19937_64 engine(0);
+  vector<uint64_t> weights(n);
+  uint64_t total = 0;
+  for (auto& weight : weights) {
+    weight = engine() % 1000;
+    total += weight;
+  }
+
+  Fenwick<uint64_t> added(n);
+  const double add = NsPerQuery(n, [&]() {
+    for (size_t i = 0; i < n; ++i)
+      added.Add(i, weights[i]);
+  });
+
+  optional<Fenwick<uint64_t>> built;
+  const double build = NsPerQuery(n, [&]() { built.emplace(weights); });
+
+  vector<uint64_t> targets(numQueries);
+  for (auto& target : targets)
+    target = engine() % total + 1;
+
+  uint64_t checksum = 0;
+  const double lowerBound = NsPerQuery(numQueries, [&]() {
+    for (const auto target : targets)
+      checksum += built->LowerBound(target);
+  });
+  const double binarySearch = NsPerQuery(numQueries, [&]() {
+    for (const auto target : targets)
+      checksum -= BinarySearch(added, target);
+  });
+
+  if (checksum != 0 || built->Sum(n) != added.Sum(n)) {
+    fprintf(stderr, "Fenwick error\n");
+    return 1;
+  }
+
+  printf("%zu elements:\n", n);
+  printf("  Add() per element:    %.1f ns\n", add);
+  printf("  Build per element:    %.1f ns\n", build);
+  printf("  LowerBound():         %.1f ns/query\n", lowerBound);
+  printf("  Binary search on Sum: %.1f ns/query\n", binarySearch);
+  return 0;
+}
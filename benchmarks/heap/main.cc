@@ -0,0 +1,98 @@
+#include "common/timing.h"
+#include "sequences/dary_heap.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "sequences/heap.h"
+
+using namespace algo;
+using namespace bench;
+using namespace std;
+
+namespace {
+using Value = pair<uint64_t, uint64_t>;
+
+// Pushes all |values| and pops them back.
+template <typename Heap>
+double PushPop(const vector<Value>& values, uint64_t& checksum) {
+  return NsPerQuery(values.size(), [&]() {
+    Heap heap;
+    for (const auto& value : values)
+      heap.Push(value);
+    while (!heap.Empty()) {
+      checksum = checksum * 31 + heap.Min().first;
+      heap.Pop();
+    }
+  });
+}
+
+// Replaces the min of a heap of |k| elements by a larger value, as
+// Merge() does for each output element.
+template <typename Heap>
+double ReplaceMin(size_t k, const vector<uint64_t>& increments, uint64_t& checksum) {
+  Heap heap;
+  for (size_t i = 0; i < k; ++i)
+    heap.Push(Value{increments[i], i});
+  return NsPerQuery(increments.size(), [&]() {
+    for (const auto increment : increments) {
+      auto& min = heap.Min();
+      checksum = checksum * 31 + min.second;
+      min.first += increment;
+      heap.OnValueIncreased(0);
+    }
+  });
+}
+
+template <typename Heap>
+bool Run(const char* name, const vector<Value>& values, size_t k, const vector<uint64_t>& increments,
+         uint64_t& pushPopChecksum, uint64_t& replaceChecksum) {
+  uint64_t pushPop = 0;
+  uint64_t replace = 0;
+  const double pushPopNs = PushPop<Heap>(values, pushPop);
+  const double replaceNs = ReplaceMin<Heap>(k, increments, replace);
+  printf("%-14s %10.1f ns %10.1f ns\n", name, pushPopNs, replaceNs);
+
+  if (pushPopChecksum == 0 && replaceChecksum == 0) {
+    pushPopChecksum = pushPop;
+    replaceChecksum = replace;
+  }
+  if (pushPop != pushPopChecksum || replace != replaceChecksum) {
+    fprintf(stderr, "%s error\n", name);
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+// Usage: heap [number of elements] [number of merged runs]
+//
+// Compares Heap with DaryHeap of different arities, on pushes and
+// pops of random elements, and on replacements of the min in a heap
+// of the given size, as in a k-way merge.
+int main(int argc, char* argv[]) {
+  const size_t n = argc > 1 ? atoll(argv[1]) : 10000000;
+  const size_t k = argc > 2 ? atoll(argv[2]) : 1024;
+
+  mt19937_64 engine(0);
+  vector<Value> values(n);
+  for (size_t i = 0; i < n; ++i)
+    values[i] = Value{engine(), i};
+  vector<uint64_t> increments(max(n, k));
+  for (auto& increment : increments)
+    increment = engine() % (1 << 20);
+
+  uint64_t pushPop = 0;
+  uint64_t replace = 0;
+  printf("%-14s %13s %13s\n", "", "Push + Pop", "Replace min");
+  bool ok = true;
+  ok &= Run<Heap<Value>>("Heap", values, k, increments, pushPop, replace);
+  ok &= Run<DaryHeap<Value, 2>>("DaryHeap<2>", values, k, increments, pushPop, replace);
+  ok &= Run<DaryHeap<Value, 4>>("DaryHeap<4>", values, k, increments, pushPop, replace);
+  ok &= Run<DaryHeap<Value, 8>>("DaryHeap<8>", values, k, increments, pushPop, replace);
+  return ok ? 0 : 1;
+}
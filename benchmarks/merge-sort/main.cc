@@ -1,23 +1,76 @@
 #include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <random>
 #include <vector>
 
+#include "common/timing.h"
 #include "sequences/merge_sort.h"
 
-int main() {
-  srand(0);
+using namespace algo;
+using namespace bench;
+using namespace std;
 
-  size_t const size = 512 * 1000000;
-  std::vector<int> data(size);
-  for (size_t i = 0; i < size; ++i)
-    data[i] = rand();
+namespace {
+const char* EngineName(MergeEngine engine) {
+  return engine == MergeEngine::Heap ? "Heap" : "LoserTree";
+}
+}  // namespace
+
+// Usage: merge-sort [number of elements] [max number of runs]
+//
+// Reports throughput of Merge() with both engines for 2, 4, ... runs
+// of random ints, and then sorts all elements by MergeSort() with
+// both engines.
+int main(int argc, char* argv[]) {
+  const size_t size = argc > 1 ? atoll(argv[1]) : 512 * 1000000;
+  const size_t maxRuns = argc > 2 ? atoll(argv[2]) : 4096;
+
+  mt19937 engine(0);
+  vector<int> data(size);
+  for (auto& elem : data)
+    elem = engine();
 
-  algo::MergeSort(data.size(), data.data(), algo::SortOptions(6144 * 1024, 64));
+  {
+    const size_t n = min(size, static_cast<size_t>(1) << 24);
+    vector<int> runs(n);
+    vector<int> out(n);
+
+    printf("Merge() of %zu elements, M elements/s:\n", n);
+    printf("%8s %12s %12s\n", "Runs", EngineName(MergeEngine::Heap), EngineName(MergeEngine::LoserTree));
+    for (size_t numRuns = 2; numRuns <= maxRuns && numRuns <= n; numRuns *= 2) {
+      copy(data.begin(), data.begin() + n, runs.begin());
+      vector<Buffer<int>> buffers;
+      for (size_t i = 0; i < numRuns; ++i) {
+        const size_t from = n * i / numRuns;
+        const size_t to = n * (i + 1) / numRuns;
+        sort(runs.begin() + from, runs.begin() + to);
+        buffers.emplace_back(runs.data() + from, to - from);
+      }
+
+      printf("%8zu", numRuns);
+      for (const auto mergeEngine : {MergeEngine::Heap, MergeEngine::LoserTree}) {
+        const double ms = Ms([&]() { Merge(buffers.size(), buffers.data(), out.data(), mergeEngine); });
+        if (!is_sorted(out.begin(), out.end())) {
+          fprintf(stderr, "Merge error\n");
+          return 1;
+        }
+        printf(" %12.1f", n / ms / 1000);
+      }
+      printf("\n");
+    }
+  }
 
-  if (!std::is_sorted(data.begin(), data.end())) {
-    fprintf(stderr, "Merge sort error\n");
-    return 1;
+  printf("\nMergeSort() of %zu elements:\n", size);
+  for (const auto mergeEngine : {MergeEngine::Heap, MergeEngine::LoserTree}) {
+    vector<int> sorted(data.begin(), data.end());
+    const double ms = Ms([&]() { MergeSort(sorted.size(), sorted.data(), SortOptions(6144 * 1024, 64, mergeEngine)); });
+    if (!is_sorted(sorted.begin(), sorted.end())) {
+      fprintf(stderr, "Merge sort error\n");
+      return 1;
+    }
+    printf("%12s %10.1f ms\n", EngineName(mergeEngine), ms);
   }
   return 0;
 }
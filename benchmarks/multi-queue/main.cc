@@ -0,0 +1,132 @@
+#include "common/timing.h"
+#include "sequences/fenwick.h"
+#include "sequences/multi_queue.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "sequences/heap.h"
+
+using namespace algo;
+using namespace bench;
+using namespace std;
+
+namespace {
+// Values are kept below this bound, so ranks can be counted by a
+// Fenwick tree.
+constexpr uint64_t MAX_VALUE = 1 << 22;
+constexpr uint64_t MAX_DELTA = 1024;
+
+// A single heap behind a mutex, as a baseline.
+class LockedHeap {
+public:
+  void Push(uint64_t value) {
+    lock_guard lock(m_mutex);
+    m_heap.Push(value);
+  }
+
+  optional<uint64_t> Pop() {
+    lock_guard lock(m_mutex);
+    if (m_heap.Empty())
+      return {};
+    const auto value = m_heap.Min();
+    m_heap.Pop();
+    return value;
+  }
+
+private:
+  mutex m_mutex;
+  Heap<uint64_t> m_heap;
+};
+
+// Runs the hold model on |numThreads| threads: each step pops a
+// value and pushes it back increased by a random delta. Returns
+// millions of steps per second.
+template <typename Queue>
+double Throughput(Queue& queue, size_t numValues, size_t numSteps, unsigned numThreads) {
+  mt19937_64 engine(0);
+  for (size_t i = 0; i < numValues; ++i)
+    queue.Push(engine() % (MAX_VALUE / 4));
+
+  const double ms = Ms([&]() {
+    vector<thread> threads;
+    for (unsigned t = 0; t < numThreads; ++t) {
+      threads.emplace_back([&, t]() {
+        mt19937_64 engine(t);
+        for (size_t i = t; i < numSteps; i += numThreads) {
+          if (const auto value = queue.Pop())
+            queue.Push(min(*value + 1 + engine() % MAX_DELTA, MAX_VALUE - 1));
+        }
+      });
+    }
+    for (auto& thread : threads)
+      thread.join();
+  });
+  return numSteps / ms / 1000;
+}
+
+// Runs the hold model on a single thread and returns the mean rank of
+// popped values among all values in the queue, where 0 is exact.
+double MeanRankError(size_t numQueues, size_t numChoices, size_t numValues, size_t numSteps) {
+  MultiQueue<uint64_t> queue(numQueues, numChoices);
+  Fenwick<int64_t> counts(MAX_VALUE);
+  mt19937_64 engine(0);
+  const auto push = [&](uint64_t value) {
+    queue.Push(value);
+    counts.Add(value, 1);
+  };
+  for (size_t i = 0; i < numValues; ++i)
+    push(engine() % (MAX_VALUE / 4));
+
+  double sum = 0;
+  for (size_t i = 0; i < numSteps; ++i) {
+    const auto value = *queue.Pop();
+    counts.Add(value, -1);
+    sum += counts.Sum(value);
+    push(min(value + 1 + engine() % MAX_DELTA, MAX_VALUE - 1));
+  }
+  return sum / numSteps;
+}
+}  // namespace
+
+// Usage: multi-queue [max number of threads] [number of values] [number of steps]
+//
+// Compares a single locked Heap with MultiQueue of c * P heaps on the
+// hold model on 1, 2, 4, ... threads, and reports rank errors of
+// MultiQueue for different numbers of heaps and choices.
+int main(int argc, char* argv[]) {
+  const unsigned maxThreads = argc > 1 ? atoi(argv[1]) : 64;
+  const size_t numValues = argc > 2 ? atoll(argv[2]) : 1000000;
+  const size_t numSteps = argc > 3 ? atoll(argv[3]) : 4000000;
+
+  printf("Throughput, Msteps/s:\n");
+  printf("%8s %12s %12s %12s %12s\n", "Threads", "Locked Heap", "c=2", "c=4", "c=4, d=1");
+  for (unsigned numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+    LockedHeap locked;
+    MultiQueue<uint64_t> c2(2 * numThreads);
+    MultiQueue<uint64_t> c4(4 * numThreads);
+    MultiQueue<uint64_t> c4d1(4 * numThreads, 1 /* numChoices */);
+    const double lockedRate = Throughput(locked, numValues, numSteps, numThreads);
+    const double c2Rate = Throughput(c2, numValues, numSteps, numThreads);
+    const double c4Rate = Throughput(c4, numValues, numSteps, numThreads);
+    const double c4d1Rate = Throughput(c4d1, numValues, numSteps, numThreads);
+    printf("%8u %12.2f %12.2f %12.2f %12.2f\n", numThreads, lockedRate, c2Rate, c4Rate, c4d1Rate);
+  }
+
+  printf("\nMean rank error of Pop() on a single thread:\n");
+  printf("%8s %10s %10s %10s\n", "Heaps", "d=1", "d=2", "d=4");
+  for (const size_t numQueues : {1, 4, 16, 64, 256}) {
+    printf("%8zu", numQueues);
+    for (const size_t numChoices : {1, 2, 4})
+      printf(" %10.1f", MeanRankError(numQueues, numChoices, numValues, numSteps / 4));
+    printf("\n");
+  }
+  return 0;
+}
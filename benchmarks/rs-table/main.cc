@@ -0,0 +1,84 @@
+#include "bits/bit_vector.h"
+#include "bits/interleaved_rs_table.h"
+#include "bits/rank_support.h"
+#include "bits/rs_table.h"
+#include "common/timing.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace algo;
+using namespace bench;
+using namespace std;
+
+namespace {
+template <RankSupport Table>
+double ScalarRank1(const Table& table, const vector<uint64_t>& ns, vector<uint64_t>& ranks) {
+  return NsPerQuery(ns.size(), [&]() {
+    for (size_t i = 0; i < ns.size(); ++i)
+      ranks[i] = table.Rank1(ns[i]);
+  });
+}
+}  // namespace
+
+// Usage: rs-table [log2 of number of bits] [number of queries]
+//
+// Default bit vector has 2^32 bits (512MB), which is much larger than
+// L3 cache on most machines. Build with USE_NATIVE_ARCH=ON, otherwise
+// popcounts are done in software.
+int main(int argc, char* argv[]) {
+  const uint64_t logNumBits = argc > 1 ? atoi(argv[1]) : 32;
+  const size_t numQueries = argc > 2 ? atoll(argv[2]) : 10000000;
+
+  mt19937_64 engine(0);
+
+  BitVector bv(static_cast<uint64_t>(1) << logNumBits);
+  for (uint64_t i = 0; i < bv.NumBlocks(); ++i)
+    bv.Block(i) = engine() & engine();
+  bv.Block(bv.NumBlocks() - 1) = 0;
+
+  RSTable rs(bv);
+
+  vector<uint64_t> ns(numQueries);
+  for (auto& n : ns)
+    n = engine() % (bv.NumBits() + 1);
+  vector<uint64_t> ranks(numQueries);
+
+  uint64_t checksum = 0;
+  const double scalar = ScalarRank1(rs, ns, ranks);
+  for (const auto rank : ranks)
+    checksum += rank;
+
+  const double batch = NsPerQuery(numQueries, [&]() { rs.Rank1(ns, ranks); });
+  for (const auto rank : ranks)
+    checksum -= rank;
+
+  if (checksum != 0) {
+    fprintf(stderr, "Batch Rank1 error\n");
+    return 1;
+  }
+
+  double interleaved = 0;
+  {
+    InterleavedRSTable table(bv);
+    interleaved = ScalarRank1(table, ns, ranks);
+    for (const auto rank : ranks)
+      checksum += rank;
+    for (const auto n : ns)
+      checksum -= rs.Rank1(n);
+  }
+
+  if (checksum != 0) {
+    fprintf(stderr, "Interleaved Rank1 error\n");
+    return 1;
+  }
+
+  printf("bits: 2^%d, queries: %zu\n", static_cast<int>(logNumBits), numQueries);
+  printf("Rank1 scalar: %.2f ns/query\n", scalar);
+  printf("Rank1 batch:  %.2f ns/query\n", batch);
+  printf("InterleavedRSTable Rank1 scalar: %.2f ns/query\n", interleaved);
+  return 0;
+}
@@ -0,0 +1,78 @@
+#include "bits/sparse_dictionary.h"
+#include "common/timing.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace algo;
+using namespace bench;
+using namespace std;
+
+namespace {
+template <uint64_t LogSize>
+int Run(size_t numKeys, size_t numQueries) {
+  mt19937_64 engine(0);
+  const uint64_t mask = LogSize == 64 ? UINT64_MAX : (static_cast<uint64_t>(1) << LogSize) - 1;
+
+  vector<uint64_t> keys(numKeys);
+  for (auto& key : keys)
+    key = engine() & mask;
+
+  SparseDictionary<LogSize> dict;
+  const double set = NsPerQuery(numKeys, [&]() {
+    for (const auto key : keys)
+      dict.Set(key);
+  });
+
+  sort(keys.begin(), keys.end());
+  keys.erase(unique(keys.begin(), keys.end()), keys.end());
+
+  vector<uint64_t> queries(numQueries);
+  for (auto& query : queries)
+    query = engine() & mask;
+
+  uint64_t checksum = 0;
+  const double succ = NsPerQuery(numQueries, [&]() {
+    for (const auto query : queries)
+      checksum += dict.Succ(query).value_or(0);
+  });
+
+  const double upperBound = NsPerQuery(numQueries, [&]() {
+    for (const auto query : queries) {
+      const auto it = upper_bound(keys.begin(), keys.end(), query);
+      checksum -= it == keys.end() ? 0 : *it;
+    }
+  });
+
+  if (checksum != 0) {
+    fprintf(stderr, "Succ error for 2^%d universe\n", static_cast<int>(LogSize));
+    return 1;
+  }
+
+  printf("2^%d universe, %zu keys, %.1f MB:\n", static_cast<int>(LogSize), keys.size(),
+         dict.SizeInBytes() / 1024.0 / 1024.0);
+  printf("  Set:         %.1f ns/op\n", set);
+  printf("  Succ:        %.1f ns/op\n", succ);
+  printf("  upper_bound: %.1f ns/op\n", upperBound);
+  return 0;
+}
+}  // namespace
+
+// Usage: sparse-dictionary [number of keys] [number of queries]
+//
+// Compares successor queries on random keys against binary search
+// over a sorted vector of the same keys.
+int main(int argc, char* argv[]) {
+  const size_t numKeys = argc > 1 ? atoll(argv[1]) : 10000000;
+  const size_t numQueries = argc > 2 ? atoll(argv[2]) : 10000000;
+
+  if (const int code = Run<32>(numKeys, numQueries))
+    return code;
+  if (const int code = Run<40>(numKeys, numQueries))
+    return code;
+  return Run<64>(numKeys, numQueries);
+}
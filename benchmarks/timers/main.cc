@@ -0,0 +1,78 @@
+#include "common/timing.h"
+#include "sequences/bucket_queue.h"
+#include "sequences/dary_heap.h"
+#include "sequences/radix_heap.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "sequences/heap.h"
+
+using namespace algo;
+using namespace bench;
+using namespace std;
+
+namespace {
+// Hold model of a timer wheel: |numTimers| timers are armed, then
+// each step fires the earliest timer and re-arms it after a delay.
+template <typename Queue>
+double Run(Queue queue, size_t numTimers, const vector<uint32_t>& delays, uint64_t& checksum) {
+  for (uint32_t i = 0; i < numTimers; ++i)
+    queue.Push(pair<uint64_t, uint32_t>{delays[i], i});
+
+  checksum = 0;
+  return NsPerQuery(delays.size() - numTimers, [&]() {
+    for (size_t i = numTimers; i < delays.size(); ++i) {
+      const auto [time, timer] = queue.Min();
+      queue.Pop();
+      checksum = checksum * 31 + time;
+      queue.Push(pair<uint64_t, uint32_t>{time + delays[i], timer});
+    }
+  });
+}
+}  // namespace
+
+// Usage: timers [number of timers] [number of steps] [max delay]
+//
+// Compares Heap, DaryHeap, RadixHeap and BucketQueue on a timer
+// workload, where each step pops the earliest timer and pushes it
+// back with a random delay.
+int main(int argc, char* argv[]) {
+  const size_t numTimers = argc > 1 ? atoll(argv[1]) : 1000000;
+  const size_t numSteps = argc > 2 ? atoll(argv[2]) : 10000000;
+  const uint32_t maxDelay = argc > 3 ? atoll(argv[3]) : 10000;
+
+  mt19937_64 engine(0);
+  vector<uint32_t> delays(numTimers + numSteps);
+  for (auto& delay : delays)
+    delay = 1 + engine() % maxDelay;
+
+  uint64_t expected = 0;
+  bool ok = true;
+  const auto report = [&](const char* name, double ns, uint64_t checksum) {
+    printf("%-12s %8.1f ns/step\n", name, ns);
+    if (name == string_view("Heap"))
+      expected = checksum;
+    if (checksum != expected) {
+      fprintf(stderr, "%s error\n", name);
+      ok = false;
+    }
+  };
+
+  printf("%zu timers, max delay %u:\n", numTimers, maxDelay);
+  uint64_t checksum = 0;
+  double ns = Run(Heap<pair<uint64_t, uint32_t>>(), numTimers, delays, checksum);
+  report("Heap", ns, checksum);
+  ns = Run(DaryHeap<pair<uint64_t, uint32_t>>(), numTimers, delays, checksum);
+  report("DaryHeap", ns, checksum);
+  ns = Run(RadixHeap<uint32_t>(), numTimers, delays, checksum);
+  report("RadixHeap", ns, checksum);
+  ns = Run(BucketQueue<uint32_t>(maxDelay), numTimers, delays, checksum);
+  report("BucketQueue", ns, checksum);
+  return ok ? 0 : 1;
+}